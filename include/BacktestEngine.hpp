@@ -4,12 +4,13 @@
 #include <vector>
 #include <thread>
 #include <mutex>
-#include <future>
+#include <algorithm>
 #include <iostream>
 #include "MarketData.hpp"
 #include "KeltnerIndicator.hpp"
 #include "TradingStrategy.hpp"
 #include "BacktestResult.hpp"
+#include "thread_pool.h"
 
 struct ParameterSet
 {
@@ -66,44 +67,41 @@ public:
         std::cout << "========================================\n"
                   << std::endl;
 
-        std::vector<std::future<BacktestResult> > futures;
+        results.resize(parameter_sets.size());
 
-        for (const auto &params : parameter_sets)
+        backtest::WorkStealingPool pool(static_cast<size_t>(std::max(num_threads, 0)));
+        for (size_t i = 0; i < parameter_sets.size(); ++i)
         {
-            futures.push_back(std::async(std::launch::async,
-                                         [this, params]()
-                                         {
-                                             BacktestResult result = this->runSingleBacktest(params);
-
-                                             std::lock_guard<std::mutex> lock(this->results_mutex);
-                                             std::cout << "Completed: EMA=" << params.ema_period
-                                                       << ", ATR=" << params.atr_period
-                                                       << ", Mult=" << params.multiplier
-                                                       << " | Trades: " << result.trades.size()
-                                                       << " | P&L: Rs " << result.total_profit_loss
-                                                       << std::endl;
-
-                                             return result;
-                                         }));
-
-            if (futures.size() >= static_cast<size_t>(num_threads))
-            {
-                for (auto &future : futures)
-                {
-                    results.push_back(future.get());
-                }
-                futures.clear();
-            }
+            pool.submit([this, &parameter_sets, i]()
+                        {
+                            const ParameterSet &params = parameter_sets[i];
+                            BacktestResult result = this->runSingleBacktest(params);
+
+                            std::lock_guard<std::mutex> lock(this->results_mutex);
+                            std::cout << "Completed: EMA=" << params.ema_period
+                                      << ", ATR=" << params.atr_period
+                                      << ", Mult=" << params.multiplier
+                                      << " | Trades: " << result.trades.size()
+                                      << " | P&L: Rs " << result.total_profit_loss
+                                      << std::endl;
+
+                            this->results[i] = std::move(result);
+                        });
         }
+        pool.wait();
 
-        for (auto &future : futures)
+        double busy_ms = 0.0, slowest_ms = 0.0;
+        for (const auto &timing : pool.getJobTimings())
         {
-            results.push_back(future.get());
+            busy_ms += timing.duration_ms;
+            slowest_ms = std::max(slowest_ms, timing.duration_ms);
         }
 
         std::cout << "\n========================================" << std::endl;
         std::cout << "All backtests completed!" << std::endl;
         std::cout << "Total results: " << results.size() << std::endl;
+        std::cout << "Total job time: " << busy_ms << " ms"
+                  << " | Slowest job: " << slowest_ms << " ms" << std::endl;
         std::cout << "========================================\n"
                   << std::endl;
     }
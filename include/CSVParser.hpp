@@ -2,91 +2,83 @@
 #define CSV_PARSER_H
 
 #include <string>
-#include <fstream>
-#include <sstream>
+#include <string_view>
+#include <vector>
+#include <chrono>
 #include <iostream>
-#include <algorithm>
 #include "MarketData.hpp"
+#include "csv_reader.h"
 
 class CSVParser
 {
 private:
-    std::string trim(const std::string &str) const
+    char delimiter_;
+
+    // Vendor dumps often write volume as "1250000.0"; like the std::stol
+    // this replaced, keep the integer part instead of rejecting the row
+    static bool parseVolume(std::string_view field, long &volume)
     {
-        size_t first = str.find_first_not_of(" \t\r\n");
-        if (first == std::string::npos)
-            return "";
-        size_t last = str.find_last_not_of(" \t\r\n");
-        return str.substr(first, (last - first + 1));
+        if (backtest::CSVReader::parseInt(field, volume))
+        {
+            return true;
+        }
+        double value;
+        if (!backtest::CSVReader::parseDouble(field, value))
+        {
+            return false;
+        }
+        volume = static_cast<long>(value);
+        return true;
     }
 
 public:
-    CSVParser() {}
+    explicit CSVParser(char delimiter = ',') : delimiter_(delimiter) {}
 
     bool loadFromFile(const std::string &filename, MarketData &market_data)
     {
-        std::ifstream file(filename);
-        if (!file.is_open())
+        backtest::CSVReader reader(delimiter_);
+        if (!reader.open(filename))
         {
-            std::cerr << "Error: Could not open file " << filename << std::endl;
             return false;
         }
 
-        std::string line;
-        bool first_line = true;
-        int line_number = 0;
+        auto start_time = std::chrono::steady_clock::now();
 
-        while (std::getline(file, line))
-        {
-            line_number++;
+        std::vector<std::string_view> tokens;
+        reader.nextRow(tokens); // Skip header
 
-            if (first_line)
-            {
-                first_line = false;
-                continue;
-            }
-
-            if (line.empty() || trim(line).empty())
+        OHLCV bar;
+        while (reader.nextRow(tokens))
+        {
+            if (tokens.size() == 1 && backtest::CSVReader::trim(tokens[0]).empty())
             {
                 continue;
             }
 
-            std::stringstream ss(line);
-            std::string token;
-            std::vector<std::string> tokens;
-
-            while (std::getline(ss, token, ','))
-            {
-                tokens.push_back(trim(token));
-            }
-
             if (tokens.size() < 6)
             {
-                std::cerr << "Warning: Line " << line_number << " has insufficient columns. Skipping." << std::endl;
+                std::cerr << "Warning: Line " << reader.lineNumber() << " has insufficient columns. Skipping." << std::endl;
                 continue;
             }
 
-            try
+            if (!backtest::CSVReader::parseDouble(tokens[1], bar.open) ||
+                !backtest::CSVReader::parseDouble(tokens[2], bar.high) ||
+                !backtest::CSVReader::parseDouble(tokens[3], bar.low) ||
+                !backtest::CSVReader::parseDouble(tokens[4], bar.close) ||
+                !parseVolume(tokens[5], bar.volume))
             {
-                OHLCV bar;
-                bar.timestamp = tokens[0];
-                bar.open = std::stod(tokens[1]);
-                bar.high = std::stod(tokens[2]);
-                bar.low = std::stod(tokens[3]);
-                bar.close = std::stod(tokens[4]);
-                bar.volume = std::stol(tokens[5]);
-
-                market_data.addBar(bar);
-            }
-            catch (const std::exception &e)
-            {
-                std::cerr << "Warning: Error parsing line " << line_number << ": " << e.what() << std::endl;
+                std::cerr << "Warning: Error parsing line " << reader.lineNumber() << std::endl;
                 continue;
             }
+
+            bar.timestamp.assign(backtest::CSVReader::trim(tokens[0]));
+            market_data.addBar(bar);
         }
 
-        file.close();
-        std::cout << "Loaded " << market_data.size() << " bars from " << filename << std::endl;
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+        double megabytes = reader.fileSize() / (1024.0 * 1024.0);
+        std::cout << "Loaded " << market_data.size() << " bars from " << filename << " ("
+                  << megabytes << " MB, " << (seconds > 0.0 ? megabytes / seconds : 0.0) << " MB/s)" << std::endl;
         return true;
     }
 };
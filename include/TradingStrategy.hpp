@@ -8,6 +8,7 @@
 #include "MarketData.hpp"
 #include "KeltnerIndicator.hpp"
 #include "Trade.hpp"
+#include "portfolio.h"
 
 class TradingStrategy
 {
@@ -54,8 +55,9 @@ public:
 
         std::vector<KeltnerBands> bands = indicator.calculate(market_data);
 
-        Trade *active_trade = nullptr;
-        double running_pnl = 0;
+        // Position state, sizing and PnL come from the engine's Portfolio;
+        // the open trade is always trades.back()
+        backtest::Portfolio portfolio(capital);
         double peak_pnl = 0;
 
         for (size_t i = std::max(indicator.getEmaPeriod(), indicator.getAtrPeriod());
@@ -70,30 +72,14 @@ public:
                 continue;
             }
 
-            if (active_trade == nullptr)
+            if (portfolio.isFlat())
             {
-                if (current_bar.close > current_bands.upper)
+                bool go_long = current_bar.close > current_bands.upper;
+                if (go_long || current_bar.close < current_bands.lower)
                 {
-                    Trade new_trade;
-                    new_trade.entry_timestamp = current_bar.timestamp;
-                    new_trade.entry_price = current_bar.close;
-                    new_trade.entry_keltner_upper = current_bands.upper;
-                    new_trade.entry_keltner_lower = current_bands.lower;
-                    new_trade.ema_period = indicator.getEmaPeriod();
-                    new_trade.atr_period = indicator.getAtrPeriod();
-                    new_trade.multiplier = indicator.getMultiplier();
-                    new_trade.investment = capital;
-                    new_trade.quantity = static_cast<int>(capital / current_bar.close);
-                    new_trade.direction = TradeDirection::LONG;
-                    new_trade.dte = 0;
+                    portfolio.open(go_long ? backtest::Direction::LONG : backtest::Direction::SHORT,
+                                   current_bar.close, i);
 
-                    trades.push_back(new_trade);
-                    active_trade = &trades.back();
-                    running_pnl = 0;
-                    peak_pnl = 0;
-                }
-                else if (current_bar.close < current_bands.lower)
-                {
                     Trade new_trade;
                     new_trade.entry_timestamp = current_bar.timestamp;
                     new_trade.entry_price = current_bar.close;
@@ -103,88 +89,59 @@ public:
                     new_trade.atr_period = indicator.getAtrPeriod();
                     new_trade.multiplier = indicator.getMultiplier();
                     new_trade.investment = capital;
-                    new_trade.quantity = static_cast<int>(capital / current_bar.close);
-                    new_trade.direction = TradeDirection::SHORT;
+                    new_trade.quantity = static_cast<int>(portfolio.position().quantity);
+                    new_trade.direction = go_long ? TradeDirection::LONG : TradeDirection::SHORT;
                     new_trade.dte = 0;
 
                     trades.push_back(new_trade);
-                    active_trade = &trades.back();
-                    running_pnl = 0;
                     peak_pnl = 0;
                 }
             }
             else
             {
-                if (active_trade->direction == TradeDirection::LONG)
-                {
-                    running_pnl = (current_bar.close - active_trade->entry_price) * active_trade->quantity;
-                }
-                else
-                {
-                    running_pnl = (active_trade->entry_price - current_bar.close) * active_trade->quantity;
-                }
+                Trade &active_trade = trades.back();
+                double running_pnl = portfolio.unrealizedPnl(current_bar.close);
 
                 if (running_pnl > peak_pnl)
                 {
                     peak_pnl = running_pnl;
-                    active_trade->max_profit_during_trade = peak_pnl;
+                    active_trade.max_profit_during_trade = peak_pnl;
                 }
 
                 double drawdown_from_peak = peak_pnl - running_pnl;
-                if (drawdown_from_peak > active_trade->max_drawdown_during_trade)
+                if (drawdown_from_peak > active_trade.max_drawdown_during_trade)
                 {
-                    active_trade->max_drawdown_during_trade = drawdown_from_peak;
+                    active_trade.max_drawdown_during_trade = drawdown_from_peak;
                 }
 
-                bool should_exit = false;
-
-                if (active_trade->direction == TradeDirection::LONG)
-                {
-                    if (current_bar.close < current_bands.middle)
-                    {
-                        should_exit = true;
-                    }
-                }
-                else
-                {
-                    if (current_bar.close > current_bands.middle)
-                    {
-                        should_exit = true;
-                    }
-                }
+                bool should_exit = active_trade.direction == TradeDirection::LONG
+                                       ? current_bar.close < current_bands.middle
+                                       : current_bar.close > current_bands.middle;
 
                 bool is_last_bar = (i == data.size() - 1);
-                bool is_eod = false;
-                if (!is_last_bar)
-                {
-                    is_eod = isEndOfDay(current_bar.timestamp, data[i + 1].timestamp);
-                }
-                else
-                {
-                    is_eod = true;
-                }
+                bool is_eod = is_last_bar || isEndOfDay(current_bar.timestamp, data[i + 1].timestamp);
 
                 if (should_exit || is_eod)
                 {
-                    active_trade->exit_timestamp = current_bar.timestamp;
-                    active_trade->exit_price = current_bar.close;
-                    active_trade->exit_keltner_upper = current_bands.upper;
-                    active_trade->exit_keltner_lower = current_bands.lower;
-
-                    active_trade = nullptr;
+                    portfolio.close(current_bar.close, i);
+                    active_trade.exit_timestamp = current_bar.timestamp;
+                    active_trade.exit_price = current_bar.close;
+                    active_trade.exit_keltner_upper = current_bands.upper;
+                    active_trade.exit_keltner_lower = current_bands.lower;
                 }
             }
         }
 
-        if (active_trade != nullptr)
+        if (portfolio.inPosition())
         {
             const OHLCV &last_bar = data.back();
             const KeltnerBands &last_bands = bands.back();
 
-            active_trade->exit_timestamp = last_bar.timestamp;
-            active_trade->exit_price = last_bar.close;
-            active_trade->exit_keltner_upper = last_bands.upper;
-            active_trade->exit_keltner_lower = last_bands.lower;
+            portfolio.close(last_bar.close, data.size() - 1);
+            trades.back().exit_timestamp = last_bar.timestamp;
+            trades.back().exit_price = last_bar.close;
+            trades.back().exit_keltner_upper = last_bands.upper;
+            trades.back().exit_keltner_lower = last_bands.lower;
         }
 
         return trades;
@@ -2,10 +2,22 @@
 #define BACKTEST_ENGINE_H
 
 #include "data_structures.h"
+#include "bar_series.h"
+#include "session_calendar.h"
+#include "session_index.h"
 #include "strategy/strategy_base.h"
+#include "indicators/indicator_cache.h"
 #include "trade_logger.h"
+#include "portfolio.h"
+#include "metrics_accumulator.h"
+#include "event_book.h"
+#include "thread_pool.h"
+#include "result_collector.h"
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace backtest
@@ -16,39 +28,390 @@ namespace backtest
     public:
         BacktestEngine(double initial_capital = 2000000.0);
 
-        // Run backtest for single strategy configuration
+        // Run backtest for single strategy configuration. Built-in
+        // strategies are dispatched to their compiled loop below.
         PerformanceMetrics runBacktest(
-            const std::vector<Bar> &bars,
+            const BarSeries &bars,
             strategy::StrategyBase *strategy,
             const StrategyParams &params,
             TradeLogger &logger);
 
-        // Run backtest for multiple parameter combinations (multithreaded)
+        // Bar loop compiled for a concrete (final) strategy type, so its
+        // isReady()/generateSignal() and the indicator reads behind them
+        // are inlined. runBacktest<strategy::StrategyBase> is the virtual
+        // path used for plugin strategies. Only bars before `end_bar` are
+        // traded; a position still open there is left out of the metrics.
+        template <typename Strategy>
+        PerformanceMetrics runBacktest(
+            const BarSeries &bars,
+            Strategy *strategy,
+            const StrategyParams &params,
+            TradeLogger &logger,
+            size_t end_bar = SIZE_MAX);
+
+        // Run one parameter set under each of `dte_filters` (params.dte_filter
+        // is ignored), logging filter k into loggers[k]. With a batch signal
+        // column every filter shares the indicators, the column and a single
+        // pass over its events; each keeps its own strategy state, position
+        // and square-offs, so results match separate runBacktest calls.
+        // Returns one entry per filter, or nothing for an unknown strategy.
+        std::vector<PerformanceMetrics> runBacktestDTEs(
+            const BarSeries &bars,
+            const StrategyParams &params,
+            const std::vector<int> &dte_filters,
+            const std::vector<TradeLogger *> &loggers,
+            size_t end_bar = SIZE_MAX);
+
+        template <typename Strategy>
+        std::vector<PerformanceMetrics> runBacktestDTEs(
+            const BarSeries &bars,
+            const StrategyParams &params,
+            const std::vector<int> &dte_filters,
+            const std::vector<TradeLogger *> &loggers,
+            size_t end_bar = SIZE_MAX);
+
+        // Run backtest for multiple parameter combinations (multithreaded).
+        // Combinations differing only in DTE filter run as one runBacktestDTEs job.
+        // All trades go to <output_dir>/trades.parquet and the metrics to
+        // <output_dir>/results_index.parquet, joined on param_id (the
+        // combination's index in param_combinations).
         std::vector<PerformanceMetrics> runOptimization(
-            const std::vector<Bar> &bars,
+            const BarSeries &bars,
             const std::string &strategy_name,
             const std::vector<StrategyParams> &param_combinations,
             const std::string &output_dir);
 
-    private:
-        double initial_capital_;
+        // Trading window and square-off time used by runBacktest
+        void setSessionCalendar(const SessionCalendar &calendar);
+        const SessionCalendar &getSessionCalendar() const { return session_; }
 
-        // Calculate performance metrics from trades
-        PerformanceMetrics calculateMetrics(
-            const std::vector<Trade> &trades,
-            const StrategyParams &params,
-            int dte_filter);
+        // Strategies with a batch signal column run event-driven by default:
+        // the loop jumps between signal bars and square-off points instead
+        // of visiting every bar. Disable to force the bar-by-bar loop.
+        void setEventDriven(bool event_driven) { event_driven_ = event_driven; }
+        bool isEventDriven() const { return event_driven_; }
+
+        // Metrics-only sweeps: runOptimization keeps no trades (metrics are
+        // accumulated as each trade closes) and writes no trade dataset,
+        // except for the top_k combinations by PnL, which are re-run
+        // afterwards to log their trades (0 = none)
+        void setMetricsOnly(bool metrics_only, size_t top_k = 0)
+        {
+            metrics_only_ = metrics_only;
+            top_k_ = top_k;
+        }
+
+        // runOptimization reports the best `top_results` per objective (see
+        // ResultCollector). With keep_all = false it also returns and
+        // indexes only those, so huge sweeps hold a bounded number of results.
+        void setTopResults(size_t top_results, bool keep_all = true)
+        {
+            top_results_ = top_results;
+            keep_all_results_ = keep_all;
+        }
+
+        // Stop a run early once it crosses one of `rules`; the result
+        // records which rule (prune_reason) and covers the bars up to that
+        // point (bars_covered). Checked as
+        // trades close and once at the middle bar of the series (prefix
+        // runs that end before it skip that rule), so it costs a few
+        // compares per trade.
+        void setPruneRules(const PruneRules &rules) { prune_rules_ = rules; }
+        const PruneRules &getPruneRules() const { return prune_rules_; }
 
-        // Check if bar is within trading hours
-        bool isWithinTradingHours(const std::string &timestamp) const;
+        // Successive halving for runOptimization: with `rungs` > 1 every
+        // combination first runs on the first 1/eta^(rungs-1) of the bars,
+        // the best 1/eta by return go on to a prefix eta times longer, and
+        // so on until the survivors run on the full series (0 or 1 = off)
+        void setSuccessiveHalving(size_t rungs, double eta = 3.0)
+        {
+            halving_rungs_ = rungs;
+            halving_eta_ = std::max(eta, 1.5);
+        }
 
-        // Check if should square off
-        bool shouldSquareOff(const std::string &timestamp) const;
+        // Worker threads for runOptimization (0 = hardware concurrency)
+        void setThreadCount(size_t num_threads);
+        // Pin optimization workers to CPUs (Linux only)
+        void setPinThreads(bool pin_threads);
+
+        // Indicator series shared by all backtests run through this engine
+        indicators::IndicatorCache &getIndicatorCache() { return indicator_cache_; }
 
         // Create strategy instance from name
         std::unique_ptr<strategy::StrategyBase> createStrategy(const std::string &name);
+
+    private:
+        double initial_capital_;
+        SessionCalendar session_;
+        indicators::IndicatorCache indicator_cache_;
+        size_t num_threads_;
+        bool pin_threads_;
+        bool event_driven_;
+        bool metrics_only_;
+        size_t top_k_;
+        size_t top_results_;
+        bool keep_all_results_;
+        PruneRules prune_rules_;
+        size_t halving_rungs_;
+        double halving_eta_;
+
+        // Day layout of the last series run event-driven, under session_
+        std::mutex session_index_mutex_;
+        std::shared_ptr<const SessionIndex> session_index_;
+        uint64_t session_index_series_;
+        size_t session_index_size_;
+
+        std::shared_ptr<const SessionIndex> getSessionIndex(const BarSeries &bars);
+
+        // Indices of the non-zero entries of a signal column
+        static void collectEvents(const std::vector<int8_t> &events, std::vector<uint32_t> &event_bars);
+
+        // Calculate every EMA the sweep needs in one EMABank pass and seed the cache
+        void precomputeEMAs(const BarSeries &bars, const std::vector<StrategyParams> &param_combinations);
+
+        // Print the collector's leaders for each objective
+        void printTopResults(const ResultCollector &results) const;
+
+        // Print per-worker job counts, steals and busy time
+        void printLoadBalance(const WorkStealingPool &pool) const;
     };
 
+    template <typename Strategy>
+    PerformanceMetrics BacktestEngine::runBacktest(
+        const BarSeries &bars,
+        Strategy *strategy,
+        const StrategyParams &params,
+        TradeLogger &logger,
+        size_t end_bar)
+    {
+        // Initialize strategy
+        strategy->setIndicatorCache(&indicator_cache_);
+        strategy->initialize(params);
+        strategy->calculateIndicators(bars);
+
+        // Trades refer to bars by index and to this run by id; no strings
+        // are built until the logger exports them
+        logger.setBarSeries(&bars);
+        uint32_t run_id = logger.internRun(strategy->getName(), params.to_string());
+
+        // With a batch signal column the strategy is only consulted on event
+        // bars; quiet bars cost a byte load
+        std::vector<int8_t> events(bars.size());
+        const bool batch = strategy->generateSignals(events.data(), events.size());
+        size_t last_quiet = SIZE_MAX;
+        const size_t end = std::min(end_bar, bars.size());
+
+        if (batch && event_driven_)
+        {
+            std::shared_ptr<const SessionIndex> index = getSessionIndex(bars);
+            std::vector<uint32_t> event_bars;
+            collectEvents(events, event_bars);
+
+            EventBook<Strategy> book(bars, *index, events.data(), strategy, params.dte_filter, run_id,
+                                     initial_capital_, logger, prune_rules_, end);
+            for (uint32_t e : event_bars)
+            {
+                if (e >= end || book.pruned())
+                {
+                    break;
+                }
+                book.onEvent(e);
+            }
+            book.finish();
+            PerformanceMetrics metrics = book.metrics().finish(params, params.dte_filter);
+            metrics.prune_reason = book.pruneReason();
+            metrics.bars_covered = book.barsCovered();
+            return metrics;
+        }
+
+        // Metrics are updated as each trade closes, so they do not depend on
+        // the logger keeping trades
+        Portfolio portfolio(initial_capital_);
+        MetricsAccumulator accumulator(initial_capital_);
+
+        const double *close = bars.close().data();
+        const int8_t *dte = bars.dte().data();
+        const int16_t *minute_of_day = bars.minuteOfDay().data();
+
+        // The trade-count rule is applied once, on reaching the middle bar of
+        // the series; a shorter prefix never gets there, so a prefix run
+        // prunes only what the full run would
+        const size_t mid = prune_rules_.min_trades_by_midpoint > 0 ? bars.size() / 2 : SIZE_MAX;
+        PruneReason pruned = PruneReason::None;
+        size_t covered = end;
+
+        // Iterate through bars
+        for (size_t i = 0; i < end; ++i)
+        {
+            if (i == mid && accumulator.tooFewTrades(prune_rules_))
+            {
+                pruned = PruneReason::MinTrades;
+                covered = i;
+                break;
+            }
+
+            // Outside the DTE filter only a square-off can happen; inside it
+            // bars outside trading hours are skipped
+            bool dte_match = params.dte_filter == -1 || dte[i] == params.dte_filter;
+            if (dte_match && !session_.isWithinTradingHours(minute_of_day[i]))
+            {
+                continue;
+            }
+
+            if (portfolio.inPosition() && session_.shouldSquareOff(minute_of_day[i]))
+            {
+                const Trade &trade = portfolio.close(close[i], i);
+                accumulator.add(trade);
+                logger.logTrade(trade);
+                pruned = accumulator.breach(prune_rules_);
+                if (pruned != PruneReason::None)
+                {
+                    covered = i + 1;
+                    break;
+                }
+                continue;
+            }
+
+            if (!dte_match || !strategy->isReady(i))
+            {
+                continue;
+            }
+
+            if (batch)
+            {
+                if (events[i] == 0)
+                {
+                    last_quiet = i;
+                    continue;
+                }
+                if (last_quiet != SIZE_MAX)
+                {
+                    strategy->syncQuietBars(last_quiet);
+                    last_quiet = SIZE_MAX;
+                }
+            }
+
+            strategy::Signal signal = strategy->generateSignal(i, bars);
+
+            // Handle signals
+            if ((signal == strategy::Signal::LONG || signal == strategy::Signal::SHORT) && portfolio.isFlat())
+            {
+                Trade &position = portfolio.open(signal == strategy::Signal::LONG ? Direction::LONG : Direction::SHORT,
+                                                 close[i], i);
+                position.dte = dte[i];
+                position.run_id = run_id;
+            }
+            else if ((signal == strategy::Signal::EXIT_LONG || signal == strategy::Signal::EXIT_SHORT) &&
+                     portfolio.inPosition())
+            {
+                const Trade &trade = portfolio.close(close[i], i);
+                accumulator.add(trade);
+                logger.logTrade(trade);
+                pruned = accumulator.breach(prune_rules_);
+                if (pruned != PruneReason::None)
+                {
+                    covered = i + 1;
+                    break;
+                }
+            }
+        }
+
+        PerformanceMetrics metrics = accumulator.finish(params, params.dte_filter);
+        metrics.prune_reason = pruned;
+        metrics.bars_covered = covered;
+        return metrics;
+    }
+
+    template <typename Strategy>
+    std::vector<PerformanceMetrics> BacktestEngine::runBacktestDTEs(
+        const BarSeries &bars,
+        const StrategyParams &params,
+        const std::vector<int> &dte_filters,
+        const std::vector<TradeLogger *> &loggers,
+        size_t end_bar)
+    {
+        const size_t num_books = dte_filters.size();
+        std::vector<PerformanceMetrics> metrics;
+        if (num_books == 0)
+        {
+            return metrics;
+        }
+
+        std::vector<StrategyParams> book_params(num_books, params);
+        std::vector<std::unique_ptr<Strategy>> strategies;
+        for (size_t k = 0; k < num_books; ++k)
+        {
+            book_params[k].dte_filter = dte_filters[k];
+            strategies.push_back(std::make_unique<Strategy>());
+        }
+
+        strategies[0]->setIndicatorCache(&indicator_cache_);
+        strategies[0]->initialize(book_params[0]);
+        strategies[0]->calculateIndicators(bars);
+
+        // The signal column does not depend on the DTE filter
+        std::vector<int8_t> events(bars.size());
+        if (!event_driven_ || !strategies[0]->generateSignals(events.data(), events.size()))
+        {
+            for (size_t k = 0; k < num_books; ++k)
+            {
+                metrics.push_back(runBacktest(bars, strategies[k].get(), book_params[k], *loggers[k], end_bar));
+            }
+            return metrics;
+        }
+
+        // Indicators of the other books are cache hits
+        for (size_t k = 1; k < num_books; ++k)
+        {
+            strategies[k]->setIndicatorCache(&indicator_cache_);
+            strategies[k]->initialize(book_params[k]);
+            strategies[k]->calculateIndicators(bars);
+        }
+
+        std::shared_ptr<const SessionIndex> index = getSessionIndex(bars);
+        std::vector<uint32_t> event_bars;
+        collectEvents(events, event_bars);
+
+        const size_t end = std::min(end_bar, bars.size());
+        std::vector<EventBook<Strategy>> books;
+        books.reserve(num_books);
+        for (size_t k = 0; k < num_books; ++k)
+        {
+            loggers[k]->setBarSeries(&bars);
+            uint32_t run_id = loggers[k]->internRun(strategies[k]->getName(), book_params[k].to_string());
+            books.emplace_back(bars, *index, events.data(), strategies[k].get(), dte_filters[k], run_id,
+                               initial_capital_, *loggers[k], prune_rules_, end);
+        }
+
+        // One pass over the events, each routed to every book still running
+        size_t running = num_books;
+        for (uint32_t e : event_bars)
+        {
+            if (e >= end || running == 0)
+            {
+                break;
+            }
+            for (EventBook<Strategy> &book : books)
+            {
+                if (book.pruned())
+                {
+                    continue;
+                }
+                book.onEvent(e);
+                running -= book.pruned() ? 1 : 0;
+            }
+        }
+
+        for (size_t k = 0; k < num_books; ++k)
+        {
+            books[k].finish();
+            metrics.push_back(books[k].metrics().finish(book_params[k], dte_filters[k]));
+            metrics.back().prune_reason = books[k].pruneReason();
+            metrics.back().bars_covered = books[k].barsCovered();
+        }
+        return metrics;
+    }
+
 } // namespace backtest
 
 #endif // BACKTEST_ENGINE_H
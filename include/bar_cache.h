@@ -0,0 +1,39 @@
+#ifndef BAR_CACHE_H
+#define BAR_CACHE_H
+
+#include "bar_series.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace backtest
+{
+
+    // Native on-disk image of a BarSeries. Every column is stored as a raw
+    // fixed-width array at a 64-byte aligned offset, followed by the string
+    // dictionaries, so a load is one mmap plus zero-copy column views
+    // instead of a Parquet decode. The header records a format version, a
+    // hash of the column layout and a fingerprint of the source files; a
+    // mismatch on any of them makes load() fail and the caller rebuild.
+    class BarCache
+    {
+    public:
+        static constexpr uint32_t kVersion = 1;
+
+        // Cheap content fingerprint of the files a cache was built from:
+        // size, modification time and a hash of the first and last 64 KB of
+        // each. Missing files contribute a fixed marker.
+        static uint64_t fingerprint(const std::vector<std::string> &paths);
+
+        // Write `bars` to `path` (via a temporary file, renamed into place)
+        static bool save(const BarSeries &bars, const std::string &path, uint64_t source_fingerprint);
+
+        // Map `path` into `bars`. Returns false, leaving `bars` untouched, if
+        // the file is missing, truncated, from another version or layout, or
+        // was built from different sources.
+        static bool load(const std::string &path, uint64_t source_fingerprint, BarSeries &bars);
+    };
+
+} // namespace backtest
+
+#endif // BAR_CACHE_H
@@ -0,0 +1,120 @@
+#ifndef BAR_SERIES_H
+#define BAR_SERIES_H
+
+#include "data_structures.h"
+#include "aligned_allocator.h"
+#include "column.h"
+#include "string_dictionary.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace backtest
+{
+
+    // Columnar (struct-of-arrays) store for market data bars.
+    // Prices live in contiguous aligned arrays, timestamps as UTC epoch
+    // nanoseconds and date strings as ids into a shared dictionary, so
+    // indicator passes only touch the columns they read. Local minute of
+    // day and trading-day index are derived once on append. Columns can
+    // also be adopted whole, as zero-copy views over loader buffers or a
+    // memory-mapped bar cache.
+    class BarSeries
+    {
+    public:
+        BarSeries();
+
+        void reserve(size_t n);
+        void clear();
+
+        // Append a row; returns false if the timestamp cannot be parsed
+        bool append(const Bar &bar);
+
+        // Columnar bulk load: adopt whole price columns (views stay views),
+        // then add each row's remaining fields with appendRowInfo().
+        // Only valid on an empty series.
+        void adoptPrices(Column<double> open, Column<double> high, Column<double> low,
+                         Column<double> close, Column<double> volume);
+
+        // Per-row counterpart of adoptPrices(); returns false if the
+        // timestamp cannot be parsed
+        bool appendRowInfo(std::string_view timestamp, std::string_view date,
+                           std::string_view weekly_expiry_date, std::string_view dt, int dte);
+
+        size_t size() const { return timestamp_.size(); }
+        bool empty() const { return timestamp_.empty(); }
+        size_t numTradingDays() const { return empty() ? 0 : day_index_.back() + 1; }
+
+        // Process-unique identity of this series' contents. Copies and
+        // cleared series get a fresh id; appends are distinguished by size().
+        uint64_t id() const { return id_.value; }
+
+        // Column access
+        const Column<double> &open() const { return open_; }
+        const Column<double> &high() const { return high_; }
+        const Column<double> &low() const { return low_; }
+        const Column<double> &close() const { return close_; }
+        const Column<double> &volume() const { return volume_; }
+        const Column<int64_t> &timestamp() const { return timestamp_; }
+        const Column<int8_t> &dte() const { return dte_; }
+        const Column<int16_t> &minuteOfDay() const { return minute_of_day_; }
+        const Column<uint32_t> &dayIndex() const { return day_index_; }
+        const Column<uint16_t> &dateId() const { return date_id_; }
+        const Column<uint16_t> &expiryId() const { return expiry_id_; }
+
+        // Decoded row fields
+        const std::string &date(size_t index) const { return dates_.lookup(date_id_[index]); }
+        const std::string &weeklyExpiryDate(size_t index) const { return dates_.lookup(expiry_id_[index]); }
+        const std::string &dt(size_t index) const { return labels_.lookup(dt_id_[index]); }
+        std::string timestampString(size_t index) const;
+        int utcOffsetSeconds() const { return utc_offset_seconds_; }
+
+        // Materialize a single row (export/debug only, not for hot loops)
+        Bar at(size_t index) const;
+
+        // Approximate heap footprint of the columns in bytes
+        size_t memoryUsage() const;
+
+    private:
+        // Serializes and maps the raw columns
+        friend class BarCache;
+
+        struct SeriesId
+        {
+            uint64_t value;
+
+            SeriesId() : value(next()) {}
+            SeriesId(const SeriesId &) : value(next()) {}
+            SeriesId &operator=(const SeriesId &)
+            {
+                value = next();
+                return *this;
+            }
+
+            static uint64_t next();
+        };
+
+        SeriesId id_;
+        Column<double> open_;
+        Column<double> high_;
+        Column<double> low_;
+        Column<double> close_;
+        Column<double> volume_;
+        Column<int64_t> timestamp_;
+        Column<int8_t> dte_;
+        Column<int16_t> minute_of_day_;
+        Column<uint32_t> day_index_;
+        Column<uint16_t> date_id_;
+        Column<uint16_t> expiry_id_;
+        Column<uint16_t> dt_id_;
+
+        StringDictionary dates_;
+        StringDictionary labels_;
+        int utc_offset_seconds_;
+        int64_t last_local_day_;
+    };
+
+} // namespace backtest
+
+#endif // BAR_SERIES_H
@@ -0,0 +1,25 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "bar_series.h"
+
+namespace backtest
+{
+
+    // Microbenchmarks run by `backtest_engine --benchmark` on the loaded data
+    class Benchmark
+    {
+    public:
+        // Bars/second of each indicator kernel for every supported instruction set,
+        // plus per-period EMA versus EMABank over the default sweep periods
+        static void runKernelBenchmarks(const BarSeries &bars, int iterations = 20);
+
+        // Nanoseconds per bar of the Portfolio state machine on its own and
+        // of a full runBacktest for each built-in strategy, through virtual
+        // calls and through the loop compiled for its type
+        static void runExecutionBenchmarks(const BarSeries &bars, int iterations = 20);
+    };
+
+} // namespace backtest
+
+#endif // BENCHMARK_H
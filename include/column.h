@@ -0,0 +1,90 @@
+#ifndef COLUMN_H
+#define COLUMN_H
+
+#include "aligned_allocator.h"
+#include <cstddef>
+#include <memory>
+
+namespace backtest
+{
+
+    // Read-mostly column of a BarSeries. Either owns aligned storage or is a
+    // zero-copy view over a buffer kept alive by `owner` (e.g. an Arrow
+    // buffer of a memory-mapped file). Mutating a view first copies it into
+    // owned storage.
+    template <typename T>
+    class Column
+    {
+    public:
+        Column() : external_(nullptr), external_size_(0) {}
+
+        static Column view(const T *data, size_t n, std::shared_ptr<const void> owner)
+        {
+            Column column;
+            column.external_ = data;
+            column.external_size_ = n;
+            column.owner_ = std::move(owner);
+            return column;
+        }
+
+        static Column adopt(AlignedVector<T> values)
+        {
+            Column column;
+            column.owned_ = std::move(values);
+            return column;
+        }
+
+        const T *data() const { return external_ ? external_ : owned_.data(); }
+        size_t size() const { return external_ ? external_size_ : owned_.size(); }
+        bool empty() const { return size() == 0; }
+        bool isView() const { return external_ != nullptr; }
+
+        const T &operator[](size_t i) const { return data()[i]; }
+        const T &back() const { return data()[size() - 1]; }
+        const T *begin() const { return data(); }
+        const T *end() const { return data() + size(); }
+
+        // Capacity hint; views are left untouched
+        void reserve(size_t n)
+        {
+            if (!external_)
+            {
+                owned_.reserve(n);
+            }
+        }
+
+        void push_back(const T &value)
+        {
+            materialize();
+            owned_.push_back(value);
+        }
+
+        void clear()
+        {
+            owned_.clear();
+            external_ = nullptr;
+            external_size_ = 0;
+            owner_.reset();
+        }
+
+    private:
+        void materialize()
+        {
+            if (external_)
+            {
+                owned_.assign(external_, external_ + external_size_);
+                external_ = nullptr;
+                external_size_ = 0;
+                owner_.reset();
+            }
+        }
+
+        AlignedVector<T> owned_;
+        const T *external_;
+        size_t external_size_;
+        std::shared_ptr<const void> owner_;
+    };
+
+} // namespace backtest
+
+#endif // COLUMN_H
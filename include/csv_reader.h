@@ -0,0 +1,76 @@
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+#include "mapped_file.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace backtest
+{
+
+    // Memory-mapped delimited-text reader shared by DataLoader and the legacy
+    // CSVParser. Delimiters and newlines are located 64 bytes at a time with
+    // SIMD compares and fields are returned as views into the mapping, so
+    // rows are tokenized without copying or allocating. Quoted fields are
+    // not supported.
+    class CSVReader
+    {
+    public:
+        explicit CSVReader(char delimiter = ',');
+        ~CSVReader();
+
+        CSVReader(const CSVReader &) = delete;
+        CSVReader &operator=(const CSVReader &) = delete;
+
+        // Map the file; prints an error and returns false on failure
+        bool open(const std::string &path);
+
+        // Read rows from caller-owned memory, e.g. one chunk of another
+        // reader's mapping
+        void open(const char *data, size_t size);
+        void close();
+
+        // Split the next non-empty line into `fields` (cleared first). Views
+        // stay valid until close(). Returns false at end of file.
+        bool nextRow(std::vector<std::string_view> &fields);
+
+        // 1-based line number of the row last returned by nextRow()
+        size_t lineNumber() const { return line_number_; }
+
+        size_t fileSize() const { return size_; }
+        const char *data() const { return data_; }
+
+        // Start of the first line beginning at or after `offset`
+        size_t lineStart(size_t offset) const;
+
+        // Drop mapped pages before `offset` that will not be read again
+        void release(size_t offset);
+
+        // Field helpers; numbers must span the whole (trimmed) field
+        static std::string_view trim(std::string_view field);
+        static bool parseDouble(std::string_view field, double &value);
+        static bool parseInt(std::string_view field, long &value);
+
+    private:
+        // Offset of the next delimiter or newline, or size_ if none remain
+        size_t nextSeparator();
+        uint64_t separatorMask(size_t block) const;
+
+        char delimiter_;
+        MappedFile file_;
+        const char *data_; // file_ or caller-owned memory
+        size_t size_;
+
+        size_t cursor_;      // start of the next unread field
+        size_t block_;       // start of the 64-byte block described by mask_
+        uint64_t mask_;      // unconsumed separator positions within block_
+        size_t line_number_;
+        size_t next_line_;
+    };
+
+} // namespace backtest
+
+#endif // CSV_READER_H
@@ -2,6 +2,10 @@
 #define DATA_LOADER_H
 
 #include "data_structures.h"
+#include "bar_series.h"
+#include "session_calendar.h"
+#include "trading_calendar.h"
+#include <optional>
 #include <vector>
 #include <string>
 
@@ -11,19 +15,78 @@ namespace backtest
     class DataLoader
     {
     public:
-        // Convert CSV to Parquet (one-time operation)
+        static constexpr size_t kDefaultRowGroupRows = 65536;
+
+        // Predicates checked against Parquet row-group statistics so row
+        // groups that cannot match are never read. The date range is also
+        // applied per row. DTE and session only prune whole row groups, and
+        // only single-day groups (ConvertOptions::min_row_group_rows = 0)
+        // can be ruled out by them: a multi-day group spans every DTE of
+        // the week. Surviving rows are still filtered by the engine.
+        struct LoadFilter
+        {
+            std::string from_date;                  // inclusive YYYY-MM-DD, empty = open
+            std::string to_date;                    // inclusive YYYY-MM-DD, empty = open
+            std::vector<int> dte;                   // allowed DTE values, empty = any
+            std::optional<SessionCalendar> session; // drop groups entirely outside the window
+
+            bool empty() const
+            {
+                return from_date.empty() && to_date.empty() && dte.empty() && !session;
+            }
+        };
+
+        struct ConvertOptions
+        {
+            size_t max_row_group_rows;
+            size_t min_row_group_rows; // cut at a DTE change only past this (0 = every change, for DTE pushdown)
+            char delimiter;
+            size_t num_threads;       // 0 = all cores
+            TradingCalendar calendar; // DTE mode and holidays
+
+            ConvertOptions()
+                : max_row_group_rows(kDefaultRowGroupRows), min_row_group_rows(kDefaultRowGroupRows / 2),
+                  delimiter('\t'), num_threads(0) {}
+        };
+
+        // Convert CSV to Parquet (one-time operation). The file is streamed in
+        // line-aligned chunks parsed on worker threads and written as they
+        // complete, so memory stays bounded. Rows are time-ordered within each
+        // chunk and written with statistics in row groups of whole DTE runs:
+        // a group grows across days and chunks until it holds
+        // min_row_group_rows, ends at the next DTE change and never exceeds
+        // max_row_group_rows. Loads prune date ranges on any layout; DTE and
+        // session pruning needs min_row_group_rows = 0 (one group per day).
         static bool convertCSVToParquet(const std::string &csv_path,
-                                        const std::string &parquet_path);
+                                        const std::string &parquet_path,
+                                        const ConvertOptions &options = ConvertOptions());
+
+        // Options that shape the converted data (DTE mode, holidays and
+        // day-sized row groups), stored in the Parquet key-value metadata by
+        // convertCSVToParquet
+        static std::string conversionTag(const ConvertOptions &options);
+
+        // Tag a Parquet file was converted with; files written before tags
+        // existed report the default options' tag, unreadable files ""
+        static std::string readConversionTag(const std::string &parquet_path);
 
         // Load data from Parquet file
-        static std::vector<Bar> loadFromParquet(const std::string &parquet_path);
+        static BarSeries loadFromParquet(const std::string &parquet_path,
+                                         const LoadFilter &filter = LoadFilter());
 
-        // Calculate DTE from dates
+        // Unfiltered load through a native BarCache at `cache_path`. The
+        // cache is keyed on a fingerprint of the Parquet file and any extra
+        // `source_paths` (e.g. the original CSV): when it matches, the
+        // columns are mapped straight from the cache, otherwise the Parquet
+        // file is decoded and the cache rewritten for the next run.
+        static BarSeries loadCached(const std::string &parquet_path,
+                                    const std::string &cache_path,
+                                    const std::vector<std::string> &source_paths = {});
+
+        // Calculate DTE from DD-MM-YYYY dates (calendar days, clamped to 1-5).
+        // Bulk conversion uses a memoizing TradingCalendar instead.
         static int calculateDTE(const std::string &current_date,
                                 const std::string &expiry_date);
-
-    private:
-        static std::vector<Bar> loadFromCSV(const std::string &csv_path);
     };
 
 } // namespace backtest
@@ -1,6 +1,7 @@
 #ifndef DATA_STRUCTURES_H
 #define DATA_STRUCTURES_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <ctime>
@@ -16,16 +17,49 @@ namespace backtest
         double high;
         double low;
         double close;
+        double volume;
         std::string date;
         std::string weekly_expiry_date;
         std::string dt;
         int dte; // Days to expiry
 
-        Bar() : open(0), high(0), low(0), close(0), dte(0) {}
+        Bar() : open(0), high(0), low(0), close(0), volume(0), dte(0) {}
     };
 
-    // Trade structure
+    enum class Direction : int8_t
+    {
+        LONG,
+        SHORT
+    };
+
+    inline const char *toString(Direction direction)
+    {
+        return direction == Direction::LONG ? "LONG" : "SHORT";
+    }
+
+    // Compact trade record written by the backtest loop. Times and dates
+    // are bar indices into the run's BarSeries and strategy/parameters an
+    // id interned once per run by TradeLogger, so recording a trade copies
+    // no strings; TradeLogger::materialize() produces the text form.
     struct Trade
+    {
+        uint32_t entry_index;
+        uint32_t exit_index;
+        double entry_price;
+        double exit_price;
+        double quantity;
+        double pnl;
+        double pnl_percentage;
+        uint32_t run_id;
+        Direction direction;
+        int8_t dte;
+
+        Trade() : entry_index(0), exit_index(0), entry_price(0), exit_price(0), quantity(0),
+                  pnl(0), pnl_percentage(0), run_id(0), direction(Direction::LONG), dte(0) {}
+    };
+
+    // Text form of a Trade for export and display
+    struct TradeRecord
     {
         std::string entry_time;
         std::string exit_time;
@@ -41,8 +75,8 @@ namespace backtest
         std::string strategy_name;
         std::string parameters;
 
-        Trade() : entry_price(0), exit_price(0), quantity(0),
-                  pnl(0), pnl_percentage(0), dte(0) {}
+        TradeRecord() : entry_price(0), exit_price(0), quantity(0),
+                        pnl(0), pnl_percentage(0), dte(0) {}
     };
 
     // Strategy parameters structure
@@ -66,6 +100,48 @@ namespace backtest
         }
     };
 
+    // Early-abort thresholds checked while a backtest runs; 0 disables a rule
+    struct PruneRules
+    {
+        double max_drawdown_pct;    // drawdown from the equity peak exceeds this
+        double min_equity;          // realized equity falls below this
+        int min_trades_by_midpoint; // fewer closed trades than this at the series' middle bar
+
+        PruneRules() : max_drawdown_pct(0), min_equity(0), min_trades_by_midpoint(0) {}
+
+        bool enabled() const
+        {
+            return max_drawdown_pct > 0 || min_equity > 0 || min_trades_by_midpoint > 0;
+        }
+    };
+
+    // Why a run stopped short of the end of its data
+    enum class PruneReason : int8_t
+    {
+        None,
+        MaxDrawdown, // PruneRules::max_drawdown_pct crossed
+        MinEquity,   // PruneRules::min_equity crossed
+        MinTrades,   // too few trades at the middle bar
+        Halving      // ranked out by a successive-halving rung
+    };
+
+    inline const char *toString(PruneReason reason)
+    {
+        switch (reason)
+        {
+        case PruneReason::MaxDrawdown:
+            return "max_drawdown";
+        case PruneReason::MinEquity:
+            return "min_equity";
+        case PruneReason::MinTrades:
+            return "min_trades";
+        case PruneReason::Halving:
+            return "halving";
+        default:
+            return "none";
+        }
+    }
+
     // Performance metrics structure
     struct PerformanceMetrics
     {
@@ -84,14 +160,25 @@ namespace backtest
         double max_drawdown;
         int consecutive_wins;
         int consecutive_losses;
+        double sharpe_ratio;  // per trade, not annualized
+        double sortino_ratio; // per trade, not annualized
+        double calmar_ratio;  // total return / max drawdown
         int dte;
+        uint32_t param_id; // index of the combination in an optimization sweep
+        PruneReason prune_reason; // None when the run was not stopped early
+        uint32_t halving_rung;    // successive-halving rung that dropped it (from 1), 0 if none
+        uint64_t bars_covered;    // the metrics cover bars [0, bars_covered)
         std::string strategy_params;
 
         PerformanceMetrics() : total_trades(0), winning_trades(0), losing_trades(0),
                                total_pnl(0), total_return_pct(0), win_rate(0),
                                avg_win(0), avg_loss(0), max_win(0), max_loss(0),
                                profit_factor(0), expectancy(0), max_drawdown(0),
-                               consecutive_wins(0), consecutive_losses(0), dte(0) {}
+                               consecutive_wins(0), consecutive_losses(0),
+                               sharpe_ratio(0), sortino_ratio(0), calmar_ratio(0), dte(0), param_id(0),
+                               prune_reason(PruneReason::None), halving_rung(0), bars_covered(0) {}
+
+        bool pruned() const { return prune_reason != PruneReason::None; }
     };
 
 } // namespace backtest
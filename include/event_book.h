@@ -0,0 +1,211 @@
+#ifndef EVENT_BOOK_H
+#define EVENT_BOOK_H
+
+#include "bar_series.h"
+#include "session_index.h"
+#include "portfolio.h"
+#include "metrics_accumulator.h"
+#include "trade_logger.h"
+#include "strategy/strategy_base.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace backtest
+{
+
+    // One position book of the event-driven backtest loop: a strategy
+    // instance, its DTE filter, a Portfolio, running metrics and the trade
+    // log, fed the event bars of a signal column in order. Produces exactly
+    // the trades of the bar-by-bar loop in BacktestEngine::runBacktest.
+    // Several books with different filters can share one pass over events.
+    // Only bars before `end` are traded, and the book stops (pruned()) as
+    // soon as a PruneRules threshold is crossed, exactly where the
+    // bar-by-bar loop would.
+    template <typename Strategy>
+    class EventBook
+    {
+    public:
+        EventBook(const BarSeries &bars, const SessionIndex &index, const int8_t *events,
+                  Strategy *strategy, int dte_filter, uint32_t run_id, double capital, TradeLogger &logger,
+                  const PruneRules &rules, size_t end)
+            : bars_(bars), index_(index), session_(index.session()), events_(events),
+              close_(bars.close().data()), dte_(bars.dte().data()),
+              minute_of_day_(bars.minuteOfDay().data()), day_index_(bars.dayIndex().data()),
+              strategy_(strategy), filter_(dte_filter), run_id_(run_id), portfolio_(capital), metrics_(capital),
+              logger_(logger), rules_(rules), end_(std::min(end, bars.size())),
+              mid_(rules.min_trades_by_midpoint > 0 ? bars.size() / 2 : SessionIndex::kNone),
+              reason_(PruneReason::None), covered_(end_),
+              next_(0), last_call_(SessionIndex::kNone), closed_at_(SessionIndex::kNone)
+        {
+        }
+
+        // Handle event bar `e` (< end); calls must come in increasing bar order
+        void onEvent(size_t e)
+        {
+            if (e >= mid_)
+            {
+                checkMidpoint();
+            }
+            if (pruned() || !visited(e))
+            {
+                return;
+            }
+
+            // An open position may hit a square-off first (possibly on e itself)
+            if (portfolio_.inPosition())
+            {
+                size_t k = index_.nextSquareOff(bars_, next_, e, filter_);
+                if (k != SessionIndex::kNone)
+                {
+                    record(portfolio_.close(close_[k], k));
+                    closed_at_ = k;
+                    next_ = k + 1;
+                    if (k == e || pruned())
+                    {
+                        return;
+                    }
+                }
+            }
+
+            if (!strategy_->isReady(e))
+            {
+                return;
+            }
+
+            syncQuietBars(e);
+
+            strategy::Signal signal = strategy_->generateSignal(e, bars_);
+            last_call_ = e;
+            next_ = e + 1;
+
+            if ((signal == strategy::Signal::LONG || signal == strategy::Signal::SHORT) && portfolio_.isFlat())
+            {
+                Trade &position = portfolio_.open(signal == strategy::Signal::LONG ? Direction::LONG : Direction::SHORT,
+                                                  close_[e], e);
+                position.dte = dte_[e];
+                position.run_id = run_id_;
+            }
+            else if ((signal == strategy::Signal::EXIT_LONG || signal == strategy::Signal::EXIT_SHORT) &&
+                     portfolio_.inPosition())
+            {
+                record(portfolio_.close(close_[e], e));
+            }
+        }
+
+        // Square off a position still open after the last event
+        void finish()
+        {
+            if (mid_ < end_)
+            {
+                checkMidpoint();
+            }
+            if (!pruned() && portfolio_.inPosition() && next_ < end_)
+            {
+                size_t k = index_.nextSquareOff(bars_, next_, end_ - 1, filter_);
+                if (k != SessionIndex::kNone)
+                {
+                    record(portfolio_.close(close_[k], k));
+                }
+            }
+        }
+
+        int dteFilter() const { return filter_; }
+        const MetricsAccumulator &metrics() const { return metrics_; }
+        bool pruned() const { return reason_ != PruneReason::None; }
+        PruneReason pruneReason() const { return reason_; }
+
+        // End of the bars the metrics cover: `end`, or where the book stopped
+        size_t barsCovered() const { return covered_; }
+
+    private:
+        void record(const Trade &trade)
+        {
+            metrics_.add(trade);
+            logger_.logTrade(trade);
+            reason_ = metrics_.breach(rules_);
+            if (pruned())
+            {
+                covered_ = trade.exit_index + 1;
+            }
+        }
+
+        // Settle square-offs before the middle bar, then apply the
+        // trade-count rule; runs once
+        void checkMidpoint()
+        {
+            if (!pruned() && portfolio_.inPosition() && next_ < mid_)
+            {
+                size_t k = index_.nextSquareOff(bars_, next_, mid_ - 1, filter_);
+                if (k != SessionIndex::kNone)
+                {
+                    record(portfolio_.close(close_[k], k));
+                    closed_at_ = k;
+                    next_ = k + 1;
+                }
+            }
+            if (!pruned() && metrics_.tooFewTrades(rules_))
+            {
+                reason_ = PruneReason::MinTrades;
+                covered_ = mid_;
+            }
+            mid_ = SessionIndex::kNone;
+        }
+
+        // Bars the bar-by-bar loop would hand to generateSignal()
+        bool visited(size_t i) const
+        {
+            return (filter_ == -1 || dte_[i] == filter_) && session_.isWithinTradingHours(minute_of_day_[i]);
+        }
+
+        // Catch the strategy up on the last quiet bar the bar-by-bar loop
+        // would have visited since the previous call, skipping days outside
+        // the DTE filter wholesale
+        void syncQuietBars(size_t e)
+        {
+            size_t lo = last_call_ == SessionIndex::kNone ? 0 : last_call_ + 1;
+            for (size_t j = e; j > lo;)
+            {
+                --j;
+                int8_t day_dte = index_.dayDTE(day_index_[j]);
+                if (filter_ != -1 && day_dte != SessionIndex::kMixedDTE && day_dte != filter_)
+                {
+                    j = std::max(index_.dayBegin(day_index_[j]), lo);
+                    continue;
+                }
+                if (j != closed_at_ && visited(j) && events_[j] == 0 && strategy_->isReady(j))
+                {
+                    strategy_->syncQuietBars(j);
+                    return;
+                }
+            }
+        }
+
+        const BarSeries &bars_;
+        const SessionIndex &index_;
+        const SessionCalendar &session_;
+        const int8_t *events_;
+        const double *close_;
+        const int8_t *dte_;
+        const int16_t *minute_of_day_;
+        const uint32_t *day_index_;
+
+        Strategy *strategy_;
+        int filter_;
+        uint32_t run_id_;
+        Portfolio portfolio_;
+        MetricsAccumulator metrics_;
+        TradeLogger &logger_;
+        PruneRules rules_;
+        size_t end_;
+        size_t mid_;  // bar of the trade-count check, kNone once done or unused
+        PruneReason reason_;
+        size_t covered_;
+
+        size_t next_;      // first bar not yet accounted for
+        size_t last_call_; // last bar passed to generateSignal()
+        size_t closed_at_; // last square-off bar
+    };
+
+} // namespace backtest
+
+#endif // EVENT_BOOK_H
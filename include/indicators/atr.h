@@ -8,20 +8,40 @@ namespace backtest
     namespace indicators
     {
 
-        class ATR : public IndicatorBase
+        class ATR final : public IndicatorBase
         {
         public:
             explicit ATR(int period);
 
-            void calculate(const std::vector<Bar> &bars) override;
+            void calculate(const BarSeries &bars) override;
             double getValue(size_t index) const override;
             bool isReady(size_t index) const override;
+            size_t memoryUsage() const override;
+
+        protected:
+            void advance(double high, double low, double close) override;
 
         private:
             int period_;
             std::vector<double> true_range_;
+            double tr_sum_;     // sum of true ranges until the first ATR value
+            double prev_close_;
         };
 
+        inline double ATR::getValue(size_t index) const
+        {
+            if (index >= values_.size())
+            {
+                return 0.0;
+            }
+            return values_[index];
+        }
+
+        inline bool ATR::isReady(size_t index) const
+        {
+            return index >= static_cast<size_t>(period_ - 1) && !values_.empty();
+        }
+
     } // namespace indicators
 } // namespace backtest
 
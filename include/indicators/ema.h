@@ -8,20 +8,44 @@ namespace backtest
     namespace indicators
     {
 
-        class EMA : public IndicatorBase
+        class EMA final : public IndicatorBase
         {
         public:
             explicit EMA(int period);
 
-            void calculate(const std::vector<Bar> &bars) override;
+            // Adopt a series already computed for this period (e.g. by EMABank);
+            // seed_sum is the sum of the first min(period, size) closes
+            EMA(int period, std::vector<double> values, double seed_sum);
+
+            void calculate(const BarSeries &bars) override;
             double getValue(size_t index) const override;
             bool isReady(size_t index) const override;
 
+        protected:
+            void advance(double high, double low, double close) override;
+
         private:
             int period_;
             double multiplier_;
+            double seed_sum_; // running sum of closes until the first EMA value
         };
 
+        // Read on every bar by strategies; defined here so backtest loops
+        // compiled for a concrete strategy inline them
+        inline double EMA::getValue(size_t index) const
+        {
+            if (index >= values_.size())
+            {
+                return 0.0;
+            }
+            return values_[index];
+        }
+
+        inline bool EMA::isReady(size_t index) const
+        {
+            return index >= static_cast<size_t>(period_ - 1) && !values_.empty();
+        }
+
     } // namespace indicators
 } // namespace backtest
 
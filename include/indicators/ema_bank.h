@@ -0,0 +1,41 @@
+#ifndef EMA_BANK_H
+#define EMA_BANK_H
+
+#include "ema.h"
+#include <memory>
+#include <vector>
+
+namespace backtest
+{
+    namespace indicators
+    {
+
+        class IndicatorCache;
+
+        // Advances many EMA recurrences together, one SIMD lane per period, so a
+        // parameter grid reads the close column once instead of once per period.
+        // Each lane is bit-identical to EMA(period).calculate().
+        class EMABank
+        {
+        public:
+            explicit EMABank(std::vector<int> periods);
+
+            void calculate(const BarSeries &bars);
+
+            const std::vector<int> &getPeriods() const { return periods_; }
+
+            // Series for one period as a regular EMA; nullptr if not in the bank
+            std::shared_ptr<const EMA> getSeries(int period) const;
+
+            // Make every series available to IndicatorCache::get<EMA>(bars, period)
+            void publish(IndicatorCache &cache, const BarSeries &bars) const;
+
+        private:
+            std::vector<int> periods_;
+            std::vector<std::shared_ptr<const EMA>> series_;
+        };
+
+    } // namespace indicators
+} // namespace backtest
+
+#endif // EMA_BANK_H
@@ -1,21 +1,53 @@
 #ifndef INDICATOR_BASE_H
 #define INDICATOR_BASE_H
 
+#include <memory>
 #include <vector>
-#include "../data_structures.h"
+#include "../bar_series.h"
 
 namespace backtest
 {
     namespace indicators
     {
 
+        class IndicatorCache;
+
         class IndicatorBase
         {
         public:
             virtual ~IndicatorBase() = default;
 
             // Calculate indicator values for all bars
-            virtual void calculate(const std::vector<Bar> &bars) = 0;
+            virtual void calculate(const BarSeries &bars) = 0;
+
+            // Calculate, pulling dependent indicators from cache when given
+            virtual void calculateWithCache(const BarSeries &bars, IndicatorCache *cache)
+            {
+                (void)cache;
+                calculate(bars);
+            }
+
+            // Advance by one bar appended after all bars consumed so far, in O(1)
+            void update(const Bar &bar) { advance(bar.high, bar.low, bar.close); }
+            void update(double high, double low, double close) { advance(high, low, close); }
+
+            // Same, reading bar `index` of a columnar series
+            void update(const BarSeries &bars, size_t index)
+            {
+                advance(bars.high()[index], bars.low()[index], bars.close()[index]);
+            }
+
+            // Stream every bar of `bars` past barCount()
+            void updateTo(const BarSeries &bars)
+            {
+                for (size_t i = barCount(); i < bars.size(); ++i)
+                {
+                    update(bars, i);
+                }
+            }
+
+            // Bars consumed by calculate() and update()
+            size_t barCount() const { return values_.size(); }
 
             // Get indicator value at specific index
             virtual double getValue(size_t index) const = 0;
@@ -23,10 +55,32 @@ namespace backtest
             // Check if indicator is ready at specific index
             virtual bool isReady(size_t index) const = 0;
 
+            // Whole computed series (same indexing as the input bars)
+            const std::vector<double> &getValues() const { return values_; }
+
+            // Bytes held by computed series (used for cache budgeting)
+            virtual size_t memoryUsage() const
+            {
+                return values_.capacity() * sizeof(double);
+            }
+
         protected:
+            // Incremental step behind update(); must match calculate() bit for bit
+            virtual void advance(double high, double low, double close) = 0;
+
             std::vector<double> values_;
         };
 
+        // Point `view` at a privately owned copy (or a fresh T(args...) if empty)
+        // that can be streamed into without touching cache-shared series
+        template <typename T, typename... Args>
+        std::shared_ptr<T> makeStreaming(std::shared_ptr<const T> &view, Args... args)
+        {
+            std::shared_ptr<T> owned = view ? std::make_shared<T>(*view) : std::make_shared<T>(args...);
+            view = owned;
+            return owned;
+        }
+
     } // namespace indicators
 } // namespace backtest
 
@@ -0,0 +1,163 @@
+#ifndef INDICATOR_CACHE_H
+#define INDICATOR_CACHE_H
+
+#include "indicator_base.h"
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace backtest
+{
+    namespace indicators
+    {
+
+        // Thread-safe memoizing store of computed indicator series, keyed on
+        // (indicator type, parameters, data series). Concurrent requests for
+        // the same key wait on a single computation. Completed entries are
+        // evicted least-recently-used first once the memory budget is exceeded;
+        // evicted series stay alive for holders of the returned pointer.
+        class IndicatorCache
+        {
+        public:
+            struct Stats
+            {
+                uint64_t hits;
+                uint64_t misses;
+                uint64_t evictions;
+                size_t entries;
+                size_t bytes;
+
+                Stats() : hits(0), misses(0), evictions(0), entries(0), bytes(0) {}
+            };
+
+            static constexpr size_t kDefaultMemoryBudget = 512 * 1024 * 1024;
+
+            explicit IndicatorCache(size_t memory_budget = kDefaultMemoryBudget);
+
+            IndicatorCache(const IndicatorCache &) = delete;
+            IndicatorCache &operator=(const IndicatorCache &) = delete;
+
+            // Return the calculated indicator T(args...) over bars, computing it once
+            template <typename T, typename... Args>
+            std::shared_ptr<const T> get(const BarSeries &bars, Args... args)
+            {
+                Key key{std::type_index(typeid(T)), {static_cast<double>(args)...}, bars.id(), bars.size()};
+
+                std::promise<Value> promise;
+                bool owner = false;
+                std::shared_future<Value> future = acquire(key, promise, owner);
+
+                if (owner)
+                {
+                    try
+                    {
+                        auto indicator = std::make_shared<T>(args...);
+                        indicator->calculateWithCache(bars, this);
+                        size_t bytes = indicator->memoryUsage();
+                        promise.set_value(indicator);
+                        complete(key, bytes);
+                    }
+                    catch (...)
+                    {
+                        promise.set_exception(std::current_exception());
+                        abandon(key);
+                        throw;
+                    }
+                }
+
+                return std::static_pointer_cast<const T>(future.get());
+            }
+
+            // Publish an already calculated T(args...) over bars; no-op if cached
+            template <typename T, typename... Args>
+            void put(std::shared_ptr<const T> indicator, const BarSeries &bars, Args... args)
+            {
+                Key key{std::type_index(typeid(T)), {static_cast<double>(args)...}, bars.id(), bars.size()};
+                insert(key, indicator, indicator->memoryUsage());
+            }
+
+            // Whether T(args...) over bars is currently cached or being computed
+            template <typename T, typename... Args>
+            bool contains(const BarSeries &bars, Args... args) const
+            {
+                Key key{std::type_index(typeid(T)), {static_cast<double>(args)...}, bars.id(), bars.size()};
+                return containsKey(key);
+            }
+
+            // Use cache when available, otherwise compute a private instance
+            template <typename T, typename... Args>
+            static std::shared_ptr<const T> fetch(IndicatorCache *cache, const BarSeries &bars, Args... args)
+            {
+                if (cache)
+                {
+                    return cache->get<T>(bars, args...);
+                }
+
+                auto indicator = std::make_shared<T>(args...);
+                indicator->calculate(bars);
+                return indicator;
+            }
+
+            Stats getStats() const;
+            size_t getMemoryBudget() const { return memory_budget_; }
+            void setMemoryBudget(size_t bytes);
+            void clear();
+
+        private:
+            using Value = std::shared_ptr<const IndicatorBase>;
+
+            struct Key
+            {
+                std::type_index type;
+                std::vector<double> params;
+                uint64_t series_id;
+                size_t series_size;
+
+                bool operator==(const Key &other) const
+                {
+                    return type == other.type && series_id == other.series_id &&
+                           series_size == other.series_size && params == other.params;
+                }
+            };
+
+            struct KeyHash
+            {
+                size_t operator()(const Key &key) const;
+            };
+
+            struct Entry
+            {
+                std::shared_future<Value> future;
+                std::list<Key>::iterator lru_position;
+                size_t bytes;
+                bool ready;
+            };
+
+            // Hit: returns the existing future. Miss: registers promise and sets owner.
+            std::shared_future<Value> acquire(const Key &key, std::promise<Value> &promise, bool &owner);
+            void complete(const Key &key, size_t bytes);
+            void insert(const Key &key, Value value, size_t bytes);
+            bool containsKey(const Key &key) const;
+            void abandon(const Key &key);
+            void evictLocked(const Key *keep);
+
+            mutable std::mutex mutex_;
+            std::unordered_map<Key, Entry, KeyHash> entries_;
+            std::list<Key> lru_; // front = most recently used
+            size_t memory_budget_;
+            size_t bytes_;
+            uint64_t hits_;
+            uint64_t misses_;
+            uint64_t evictions_;
+        };
+
+    } // namespace indicators
+} // namespace backtest
+
+#endif // INDICATOR_CACHE_H
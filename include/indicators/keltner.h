@@ -4,6 +4,7 @@
 #include "indicator_base.h"
 #include "ema.h"
 #include "atr.h"
+#include <memory>
 
 namespace backtest
 {
@@ -15,21 +16,32 @@ namespace backtest
         public:
             KeltnerChannel(int ema_period, int atr_period, double multiplier);
 
-            void calculate(const std::vector<Bar> &bars) override;
+            // Deep-copies streaming EMA/ATR so copies advance independently
+            KeltnerChannel(const KeltnerChannel &other);
+            KeltnerChannel &operator=(const KeltnerChannel &) = delete;
+
+            void calculate(const BarSeries &bars) override;
+            void calculateWithCache(const BarSeries &bars, IndicatorCache *cache) override;
             double getValue(size_t index) const override; // Returns middle line
             bool isReady(size_t index) const override;
+            size_t memoryUsage() const override;
 
             // Get channel bands
             double getUpperBand(size_t index) const;
             double getLowerBand(size_t index) const;
             double getMiddleLine(size_t index) const;
 
+        protected:
+            void advance(double high, double low, double close) override;
+
         private:
             int ema_period_;
             int atr_period_;
             double multiplier_;
-            EMA ema_;
-            ATR atr_;
+            std::shared_ptr<const EMA> ema_;
+            std::shared_ptr<const ATR> atr_;
+            std::shared_ptr<EMA> streaming_ema_; // owned copies once update() is used
+            std::shared_ptr<ATR> streaming_atr_;
             std::vector<double> upper_band_;
             std::vector<double> lower_band_;
         };
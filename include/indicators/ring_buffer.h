@@ -0,0 +1,62 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <cstddef>
+#include <vector>
+
+namespace backtest
+{
+    namespace indicators
+    {
+
+        // Fixed-capacity FIFO; pushing into a full buffer overwrites the oldest element
+        template <typename T>
+        class RingBuffer
+        {
+        public:
+            explicit RingBuffer(size_t capacity = 0) : data_(capacity), head_(0), size_(0) {}
+
+            void push_back(const T &value)
+            {
+                if (data_.empty())
+                {
+                    return;
+                }
+
+                data_[(head_ + size_) % data_.size()] = value;
+                if (size_ < data_.size())
+                {
+                    ++size_;
+                }
+                else
+                {
+                    head_ = (head_ + 1) % data_.size();
+                }
+            }
+
+            // Oldest element
+            const T &front() const { return data_[head_]; }
+
+            // i-th oldest element
+            const T &operator[](size_t i) const { return data_[(head_ + i) % data_.size()]; }
+
+            size_t size() const { return size_; }
+            size_t capacity() const { return data_.size(); }
+            bool full() const { return size_ == data_.size(); }
+
+            void clear()
+            {
+                head_ = 0;
+                size_ = 0;
+            }
+
+        private:
+            std::vector<T> data_;
+            size_t head_;
+            size_t size_;
+        };
+
+    } // namespace indicators
+} // namespace backtest
+
+#endif // RING_BUFFER_H
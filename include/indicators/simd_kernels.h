@@ -0,0 +1,59 @@
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace backtest
+{
+    namespace indicators
+    {
+        namespace simd
+        {
+
+            // Data-parallel indicator stages over columnar arrays. Every variant
+            // produces bit-identical results to the scalar one (no FMA contraction).
+            struct Kernels
+            {
+                const char *name;
+
+                // out[0] = high[0] - low[0]
+                // out[i] = max(high[i] - low[i], |high[i] - close[i-1]|, |low[i] - close[i-1]|)
+                void (*true_range)(const double *high, const double *low, const double *close,
+                                   double *out, size_t n);
+
+                // upper[i] = middle[i] + multiplier * width[i], lower[i] = middle[i] - multiplier * width[i]
+                void (*bands)(const double *middle, const double *width, double multiplier,
+                              double *upper, double *lower, size_t n);
+
+                // out[i] = (high[i] + low[i]) / 2
+                void (*midpoint)(const double *high, const double *low, double *out, size_t n);
+
+                // Advance `lanes` independent EMA recurrences over bars [begin, end):
+                // state[k] = (close[i] - state[k]) * alpha[k] + state[k]; out[k][i] = state[k]
+                void (*ema_lanes)(const double *close, size_t begin, size_t end, const double *alpha,
+                                  double *state, double *const *out, size_t lanes);
+
+                // Signal events, out[0] = 0:
+                // out[i] = +1 if fast[i-1] <= slow[i-1] && fast[i] > slow[i],
+                //          -1 if fast[i-1] >= slow[i-1] && fast[i] < slow[i], else 0
+                void (*crossover)(const double *fast, const double *slow, int8_t *out, size_t n);
+
+                // out[i] = +1 if trend goes -1 -> 1 at i, -1 if 1 -> -1, else 0; out[0] = 0
+                void (*trend_flip)(const int *trend, int8_t *out, size_t n);
+            };
+
+            const Kernels &scalarKernels();
+
+            // Widest instruction set supported by the running CPU, resolved once
+            const Kernels &activeKernels();
+
+            // All variants usable on this CPU, scalar first (for benchmarking)
+            std::vector<const Kernels *> availableKernels();
+
+        } // namespace simd
+    } // namespace indicators
+} // namespace backtest
+
+#endif // SIMD_KERNELS_H
@@ -2,6 +2,7 @@
 #define SMA_H
 
 #include "indicator_base.h"
+#include "ring_buffer.h"
 
 namespace backtest {
 namespace indicators {
@@ -10,12 +11,17 @@ class SMA : public IndicatorBase {
 public:
     explicit SMA(int period);
     
-    void calculate(const std::vector<Bar>& bars) override;
+    void calculate(const BarSeries& bars) override;
     double getValue(size_t index) const override;
     bool isReady(size_t index) const override;
-    
+
+protected:
+    void advance(double high, double low, double close) override;
+
 private:
     int period_;
+    double sum_;                  // rolling sum of the current window
+    RingBuffer<double> window_;   // last `period` closes
 };
 
 } // namespace indicators
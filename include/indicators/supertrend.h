@@ -3,31 +3,72 @@
 
 #include "indicator_base.h"
 #include "atr.h"
+#include <memory>
 
 namespace backtest
 {
     namespace indicators
     {
 
-        class Supertrend : public IndicatorBase
+        class Supertrend final : public IndicatorBase
         {
         public:
             Supertrend(int period, double multiplier);
 
-            void calculate(const std::vector<Bar> &bars) override;
+            // Deep-copies a streaming ATR so copies advance independently
+            Supertrend(const Supertrend &other);
+            Supertrend &operator=(const Supertrend &) = delete;
+
+            void calculate(const BarSeries &bars) override;
+            void calculateWithCache(const BarSeries &bars, IndicatorCache *cache) override;
             double getValue(size_t index) const override;
             bool isReady(size_t index) const override;
+            size_t memoryUsage() const override;
 
             // Get trend direction: 1 for uptrend, -1 for downtrend
             int getTrend(size_t index) const;
+            const std::vector<int> &getTrends() const { return trend_; }
+
+        protected:
+            void advance(double high, double low, double close) override;
 
         private:
             int period_;
             double multiplier_;
-            ATR atr_;
+            std::shared_ptr<const ATR> atr_;
+            std::shared_ptr<ATR> streaming_atr_; // owned copy of atr_ once update() is used
             std::vector<int> trend_;
+
+            // Carry-forward state for update()
+            double final_upper_;
+            double final_lower_;
+            double prev_close_;
         };
 
+        // Per-bar accessors, inline for the same reason as EMA's
+        inline double Supertrend::getValue(size_t index) const
+        {
+            if (index >= values_.size())
+            {
+                return 0.0;
+            }
+            return values_[index];
+        }
+
+        inline bool Supertrend::isReady(size_t index) const
+        {
+            return atr_ && atr_->isReady(index) && index < trend_.size();
+        }
+
+        inline int Supertrend::getTrend(size_t index) const
+        {
+            if (index >= trend_.size())
+            {
+                return 0;
+            }
+            return trend_[index];
+        }
+
     } // namespace indicators
 } // namespace backtest
 
@@ -0,0 +1,45 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace backtest
+{
+
+    // Read-only view of a whole file: memory-mapped where the platform
+    // supports it, otherwise read into a private buffer
+    class MappedFile
+    {
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        // Prints nothing; returns false if the file cannot be opened
+        bool open(const std::string &path);
+        void close();
+
+        const char *data() const { return data_; }
+        size_t size() const { return size_; }
+        bool isOpen() const { return open_; }
+
+        // Hint that the file will be read front to back once
+        void adviseSequential();
+
+        // Drop mapped pages before `offset` that will not be read again
+        void release(size_t offset);
+
+    private:
+        const char *data_;
+        size_t size_;
+        bool mapped_;
+        bool open_;
+        std::string buffer_;
+    };
+
+} // namespace backtest
+
+#endif // MAPPED_FILE_H
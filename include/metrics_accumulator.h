@@ -0,0 +1,111 @@
+#ifndef METRICS_ACCUMULATOR_H
+#define METRICS_ACCUMULATOR_H
+
+#include "data_structures.h"
+#include <algorithm>
+#include <cmath>
+
+namespace backtest
+{
+
+    // PerformanceMetrics built incrementally as trades close, in O(1)
+    // memory: counts and sums, Welford mean/variance of trade PnL, running
+    // equity peak and drawdown, and win/loss streaks. A run no longer needs
+    // its trades retained (or walked again) to report its metrics.
+    class MetricsAccumulator
+    {
+    public:
+        explicit MetricsAccumulator(double initial_capital)
+            : initial_capital_(initial_capital), count_(0), wins_(0), total_pnl_(0.0),
+              gross_wins_(0.0), gross_losses_(0.0), max_win_(0.0), max_loss_(0.0),
+              mean_(0.0), m2_(0.0), downside_sq_(0.0),
+              equity_(initial_capital), peak_(initial_capital), max_drawdown_(0.0),
+              win_streak_(0), loss_streak_(0), max_win_streak_(0), max_loss_streak_(0) {}
+
+        void add(const Trade &trade) { add(trade.pnl); }
+
+        void add(double pnl)
+        {
+            ++count_;
+            total_pnl_ += pnl;
+
+            if (pnl > 0)
+            {
+                ++wins_;
+                gross_wins_ += pnl;
+                max_win_ = std::max(max_win_, pnl);
+                loss_streak_ = 0;
+                max_win_streak_ = std::max(max_win_streak_, ++win_streak_);
+            }
+            else
+            {
+                gross_losses_ += std::abs(pnl);
+                max_loss_ = std::min(max_loss_, pnl);
+                downside_sq_ += pnl * pnl;
+                win_streak_ = 0;
+                max_loss_streak_ = std::max(max_loss_streak_, ++loss_streak_);
+            }
+
+            double delta = pnl - mean_;
+            mean_ += delta / count_;
+            m2_ += delta * (pnl - mean_);
+
+            equity_ += pnl;
+            peak_ = std::max(peak_, equity_);
+            max_drawdown_ = std::max(max_drawdown_, ((peak_ - equity_) / peak_) * 100.0);
+        }
+
+        int count() const { return count_; }
+        double totalPnl() const { return total_pnl_; }
+        double equity() const { return equity_; }
+
+        // Largest peak-to-trough decline so far, in percent of the peak
+        double maxDrawdown() const { return max_drawdown_; }
+
+        // The drawdown or equity rule the trades so far break, if any
+        PruneReason breach(const PruneRules &rules) const
+        {
+            if (rules.max_drawdown_pct > 0 && max_drawdown_ > rules.max_drawdown_pct)
+            {
+                return PruneReason::MaxDrawdown;
+            }
+            if (rules.min_equity > 0 && equity_ < rules.min_equity)
+            {
+                return PruneReason::MinEquity;
+            }
+            return PruneReason::None;
+        }
+
+        // Whether a run at its middle bar has too few trades
+        bool tooFewTrades(const PruneRules &rules) const
+        {
+            return rules.min_trades_by_midpoint > 0 && count_ < rules.min_trades_by_midpoint;
+        }
+
+        // Metrics of the trades added so far
+        PerformanceMetrics finish(const StrategyParams &params, int dte_filter) const;
+
+    private:
+        double initial_capital_;
+        int count_;
+        int wins_;
+        double total_pnl_;
+        double gross_wins_;
+        double gross_losses_;
+        double max_win_;
+        double max_loss_;
+        double mean_;        // Welford running mean of trade PnL
+        double m2_;          // Welford sum of squared deviations
+        double downside_sq_; // sum of squared non-positive trade PnL
+        double equity_;
+        double peak_;
+        double max_drawdown_;
+        int win_streak_;
+        int loss_streak_;
+        int max_win_streak_;
+        int max_loss_streak_;
+    };
+
+} // namespace backtest
+
+#endif // METRICS_ACCUMULATOR_H
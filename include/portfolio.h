@@ -0,0 +1,74 @@
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include "data_structures.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace backtest
+{
+
+    // Single-position state machine shared by BacktestEngine::runBacktest
+    // and the legacy TradingStrategy::executeBacktest. Flat, long and short
+    // are one signed multiplier (0, +1, -1), so PnL is the same expression
+    // for both directions and nothing allocates.
+    class Portfolio
+    {
+    public:
+        explicit Portfolio(double capital) : capital_(capital), sign_(0.0) {}
+
+        bool isFlat() const { return sign_ == 0.0; }
+        bool inPosition() const { return sign_ != 0.0; }
+
+        // Open (or most recently closed) position
+        const Trade &position() const { return position_; }
+
+        // Whole units the capital buys at `price`
+        double size(double price) const { return std::floor(capital_ / price); }
+
+        // Enter at `price` on bar `index` and return the position so the
+        // caller can annotate it (DTE, run id). No-op if already in one.
+        Trade &open(Direction direction, double price, size_t index)
+        {
+            if (inPosition())
+            {
+                return position_;
+            }
+
+            position_ = Trade();
+            position_.entry_index = static_cast<uint32_t>(index);
+            position_.entry_price = price;
+            position_.quantity = size(price);
+            position_.direction = direction;
+            sign_ = direction == Direction::LONG ? 1.0 : -1.0;
+            return position_;
+        }
+
+        // Mark-to-market PnL of the open position (0 when flat)
+        double unrealizedPnl(double price) const
+        {
+            return (price - position_.entry_price) * sign_ * position_.quantity;
+        }
+
+        // Exit at `price` on bar `index` and return the completed trade.
+        // Only valid while in a position.
+        const Trade &close(double price, size_t index)
+        {
+            position_.exit_index = static_cast<uint32_t>(index);
+            position_.exit_price = price;
+            position_.pnl = unrealizedPnl(price);
+            position_.pnl_percentage = (position_.pnl / (position_.entry_price * position_.quantity)) * 100.0;
+            sign_ = 0.0;
+            return position_;
+        }
+
+    private:
+        double capital_;
+        double sign_; // +1 long, -1 short, 0 flat
+        Trade position_;
+    };
+
+} // namespace backtest
+
+#endif // PORTFOLIO_H
@@ -0,0 +1,69 @@
+#ifndef RESULT_COLLECTOR_H
+#define RESULT_COLLECTOR_H
+
+#include "data_structures.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace backtest
+{
+
+    // Optimization results gathered without a shared lock. Each worker
+    // thread appends to its own shard (cache-line aligned, so shards do not
+    // false-share) and the shards are merged once the sweep is done. Every
+    // shard also keeps a bounded min-heap of the best `top_k` results per
+    // objective, so the leaders are known even when the full result list is
+    // not kept.
+    class ResultCollector
+    {
+    public:
+        enum class Objective
+        {
+            Return,                 // total_return_pct
+            ProfitFactor,           // profit_factor
+            DrawdownAdjustedReturn, // total_return_pct / max(max_drawdown, 1%)
+            Count
+        };
+
+        static const char *name(Objective objective);
+        static double score(const PerformanceMetrics &metrics, Objective objective);
+
+        // `keep_all` = false keeps only the per-objective heaps
+        ResultCollector(size_t num_shards, size_t top_k, bool keep_all = true);
+
+        // Record a result in `shard`; each shard must only be used by one
+        // thread at a time (a pool worker passes its own index). Pruned
+        // results are kept but never enter the top lists.
+        void add(size_t shard, const PerformanceMetrics &metrics);
+
+        size_t count() const;
+        size_t prunedCount() const;
+        size_t topK() const { return top_k_; }
+
+        // Every kept result, ordered by param_id; empties the shards
+        std::vector<PerformanceMetrics> takeAll();
+
+        // Best results for `objective`, best first (ties by lower param_id)
+        std::vector<PerformanceMetrics> top(Objective objective) const;
+
+        // Union of all top lists, ordered by param_id
+        std::vector<PerformanceMetrics> topUnion() const;
+
+    private:
+        struct alignas(64) Shard
+        {
+            std::vector<PerformanceMetrics> results;
+            std::vector<PerformanceMetrics> heaps[static_cast<size_t>(Objective::Count)];
+            size_t count = 0;
+            size_t pruned = 0;
+        };
+
+        std::vector<std::unique_ptr<Shard>> shards_;
+        size_t top_k_;
+        bool keep_all_;
+    };
+
+} // namespace backtest
+
+#endif // RESULT_COLLECTOR_H
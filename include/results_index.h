@@ -0,0 +1,28 @@
+#ifndef RESULTS_INDEX_H
+#define RESULTS_INDEX_H
+
+#include "data_structures.h"
+#include <string>
+#include <vector>
+
+namespace backtest
+{
+
+    // Parquet table of an optimization sweep's metrics, one row per
+    // parameter combination ordered by param_id. The trade dataset written
+    // by TradeWriter carries the same param_id on every trade, so the two
+    // join without repeating run parameters per trade. The raw parameter
+    // values of each combination (looked up in `param_combinations` by
+    // param_id) go to param_0..param_k, since the strategy_params label
+    // rounds them to integers.
+    class ResultsIndex
+    {
+    public:
+        static bool save(const std::vector<PerformanceMetrics> &results,
+                         const std::vector<StrategyParams> &param_combinations,
+                         const std::string &path);
+    };
+
+} // namespace backtest
+
+#endif // RESULTS_INDEX_H
@@ -0,0 +1,37 @@
+#ifndef SESSION_CALENDAR_H
+#define SESSION_CALENDAR_H
+
+#include <string>
+
+namespace backtest
+{
+
+    // Intraday session window expressed in local minutes of day so session
+    // checks reduce to integer comparisons against BarSeries::minuteOfDay()
+    struct SessionCalendar
+    {
+        int open_minute;       // first minute trading is allowed
+        int close_minute;      // last minute trading is allowed
+        int square_off_minute; // positions are closed at or after this minute
+
+        SessionCalendar() : open_minute(9 * 60 + 15),     // 09:15
+                            close_minute(15 * 60 + 25),   // 15:25
+                            square_off_minute(15 * 60 + 25) {}
+
+        bool isWithinTradingHours(int minute_of_day) const
+        {
+            return minute_of_day >= open_minute && minute_of_day <= close_minute;
+        }
+
+        bool shouldSquareOff(int minute_of_day) const
+        {
+            return minute_of_day >= square_off_minute;
+        }
+
+        // Parse "HH:MM-HH:MM"; square-off is set to the window end
+        static bool parse(const std::string &window, SessionCalendar &calendar);
+    };
+
+} // namespace backtest
+
+#endif // SESSION_CALENDAR_H
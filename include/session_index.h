@@ -0,0 +1,50 @@
+#ifndef SESSION_INDEX_H
+#define SESSION_INDEX_H
+
+#include "bar_series.h"
+#include "session_calendar.h"
+#include <cstdint>
+#include <vector>
+
+namespace backtest
+{
+
+    // Per-day layout of a BarSeries under one SessionCalendar, built in one
+    // pass. Lets the event-driven backtest loop jump straight to each day's
+    // square-off window and skip whole days outside a DTE filter instead of
+    // testing every bar.
+    class SessionIndex
+    {
+    public:
+        static constexpr int8_t kMixedDTE = INT8_MIN;
+        static constexpr size_t kNone = SIZE_MAX;
+
+        SessionIndex(const BarSeries &bars, const SessionCalendar &session);
+
+        const SessionCalendar &session() const { return session_; }
+        size_t numDays() const { return square_off_begin_.size(); }
+
+        size_t dayBegin(size_t day) const { return day_begin_[day]; }
+        size_t dayEnd(size_t day) const { return day_begin_[day + 1]; }
+
+        // First bar of the day at or after the square-off minute (dayEnd if none)
+        size_t squareOffBegin(size_t day) const { return square_off_begin_[day]; }
+
+        // DTE shared by every bar of the day, or kMixedDTE
+        int8_t dayDTE(size_t day) const { return day_dte_[day]; }
+
+        // First bar in [from, to] where the dense loop squares off an open
+        // position: at/after the square-off minute and either inside trading
+        // hours or outside `dte_filter` (-1 = all). kNone if there is none.
+        size_t nextSquareOff(const BarSeries &bars, size_t from, size_t to, int dte_filter) const;
+
+    private:
+        SessionCalendar session_;
+        std::vector<uint32_t> day_begin_; // numDays() + 1 entries
+        std::vector<uint32_t> square_off_begin_;
+        std::vector<int8_t> day_dte_;
+    };
+
+} // namespace backtest
+
+#endif // SESSION_INDEX_H
@@ -10,27 +10,85 @@ namespace backtest
     namespace strategy
     {
 
-        class EMACrossover : public StrategyBase
+        class EMACrossover final : public StrategyBase
         {
         public:
             EMACrossover();
 
             void initialize(const StrategyParams &params) override;
-            void calculateIndicators(const std::vector<Bar> &bars) override;
-            Signal generateSignal(size_t index, const std::vector<Bar> &bars) override;
+            void calculateIndicators(const BarSeries &bars) override;
+            void updateIndicators(const BarSeries &bars) override;
+            Signal generateSignal(size_t index, const BarSeries &bars) override;
             bool isReady(size_t index) const override;
+            bool generateSignals(int8_t *events, size_t n) const override;
             std::string getName() const override { return "EMA_Crossover"; }
             std::string getParamsString() const override;
+            std::vector<int> getEMAPeriods() const override { return {fast_period_, slow_period_}; }
 
         private:
             int fast_period_;
             int slow_period_;
-            std::unique_ptr<indicators::EMA> fast_ema_;
-            std::unique_ptr<indicators::EMA> slow_ema_;
+            std::shared_ptr<const indicators::EMA> fast_ema_;
+            std::shared_ptr<const indicators::EMA> slow_ema_;
+            std::shared_ptr<indicators::EMA> fast_stream_; // owned copies once streaming
+            std::shared_ptr<indicators::EMA> slow_stream_;
             bool in_position_;
             bool was_long_;
         };
 
+        // Per-bar hooks are inline so BacktestEngine::runBacktest<EMACrossover>
+        // compiles them into its bar loop
+        inline Signal EMACrossover::generateSignal(size_t index, const BarSeries &)
+        {
+            if (!isReady(index) || index == 0)
+            {
+                return Signal::NONE;
+            }
+
+            double fast_current = fast_ema_->getValue(index);
+            double slow_current = slow_ema_->getValue(index);
+            double fast_prev = fast_ema_->getValue(index - 1);
+            double slow_prev = slow_ema_->getValue(index - 1);
+
+            // Bullish crossover
+            if (fast_prev <= slow_prev && fast_current > slow_current)
+            {
+                if (in_position_ && !was_long_)
+                {
+                    return Signal::EXIT_SHORT;
+                }
+                if (!in_position_)
+                {
+                    in_position_ = true;
+                    was_long_ = true;
+                    return Signal::LONG;
+                }
+            }
+
+            // Bearish crossover
+            if (fast_prev >= slow_prev && fast_current < slow_current)
+            {
+                if (in_position_ && was_long_)
+                {
+                    return Signal::EXIT_LONG;
+                }
+                if (!in_position_)
+                {
+                    in_position_ = true;
+                    was_long_ = false;
+                    return Signal::SHORT;
+                }
+            }
+
+            return Signal::NONE;
+        }
+
+        inline bool EMACrossover::isReady(size_t index) const
+        {
+            return fast_ema_ && slow_ema_ &&
+                   fast_ema_->isReady(index) && slow_ema_->isReady(index);
+        }
+
     } // namespace strategy
 } // namespace backtest
 
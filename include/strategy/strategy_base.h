@@ -1,7 +1,9 @@
 #ifndef STRATEGY_BASE_H
 #define STRATEGY_BASE_H
 
-#include "../data_structures.h"
+#include "../bar_series.h"
+#include "../indicators/indicator_cache.h"
+#include <cstdint>
 #include <vector>
 #include <memory>
 
@@ -24,23 +26,55 @@ namespace backtest
         public:
             virtual ~StrategyBase() = default;
 
+            // Share computed indicators with other strategy instances (optional)
+            void setIndicatorCache(indicators::IndicatorCache *cache) { indicator_cache_ = cache; }
+
             // Initialize strategy with parameters
             virtual void initialize(const StrategyParams &params) = 0;
 
             // Calculate indicators for all bars
-            virtual void calculateIndicators(const std::vector<Bar> &bars) = 0;
+            virtual void calculateIndicators(const BarSeries &bars) = 0;
+
+            // Extend indicators over bars appended since the last call, so the
+            // same strategy can run on a live-growing series (default recomputes)
+            virtual void updateIndicators(const BarSeries &bars) { calculateIndicators(bars); }
 
             // Generate signal at specific bar index
-            virtual Signal generateSignal(size_t index, const std::vector<Bar> &bars) = 0;
+            virtual Signal generateSignal(size_t index, const BarSeries &bars) = 0;
 
             // Check if strategy is ready at specific index
             virtual bool isReady(size_t index) const = 0;
 
+            // Optional batch form of generateSignal(), valid after
+            // calculateIndicators(): write one raw event per bar into
+            // events[0, n) with vector kernels (+1 bullish, -1 bearish, 0 none,
+            // and 0 wherever isReady() is false). generateSignal() must return
+            // NONE on every bar whose event is 0, so the engine only calls it
+            // on event bars. Returns false if unsupported.
+            virtual bool generateSignals(int8_t *events, size_t n) const
+            {
+                (void)events;
+                (void)n;
+                return false;
+            }
+
+            // Batch mode: before calling generateSignal() on an event bar, the
+            // engine passes the last quiet bar it skipped since the previous
+            // call, so state generateSignal() would have updated there is caught up
+            virtual void syncQuietBars(size_t last_index) { (void)last_index; }
+
             // Get strategy name
             virtual std::string getName() const = 0;
 
             // Get parameters as string
             virtual std::string getParamsString() const = 0;
+
+            // EMA periods calculateIndicators() will request, so sweeps can
+            // compute them together in one EMABank pass
+            virtual std::vector<int> getEMAPeriods() const { return {}; }
+
+        protected:
+            indicators::IndicatorCache *indicator_cache_ = nullptr;
         };
 
     } // namespace strategy
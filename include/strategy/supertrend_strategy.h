@@ -10,26 +10,81 @@ namespace backtest
     namespace strategy
     {
 
-        class SupertrendStrategy : public StrategyBase
+        class SupertrendStrategy final : public StrategyBase
         {
         public:
             SupertrendStrategy();
 
             void initialize(const StrategyParams &params) override;
-            void calculateIndicators(const std::vector<Bar> &bars) override;
-            Signal generateSignal(size_t index, const std::vector<Bar> &bars) override;
+            void calculateIndicators(const BarSeries &bars) override;
+            void updateIndicators(const BarSeries &bars) override;
+            Signal generateSignal(size_t index, const BarSeries &bars) override;
             bool isReady(size_t index) const override;
+            bool generateSignals(int8_t *events, size_t n) const override;
+            void syncQuietBars(size_t last_index) override { last_trend_ = supertrend_->getTrend(last_index); }
             std::string getName() const override { return "Supertrend"; }
             std::string getParamsString() const override;
 
         private:
             int period_;
             double multiplier_;
-            std::unique_ptr<indicators::Supertrend> supertrend_;
+            std::shared_ptr<const indicators::Supertrend> supertrend_;
+            std::shared_ptr<indicators::Supertrend> stream_; // owned copy once streaming
             bool in_position_;
             int last_trend_;
         };
 
+        inline Signal SupertrendStrategy::generateSignal(size_t index, const BarSeries &)
+        {
+            if (!isReady(index) || index == 0)
+            {
+                return Signal::NONE;
+            }
+
+            int current_trend = supertrend_->getTrend(index);
+            int prev_trend = supertrend_->getTrend(index - 1);
+
+            // Trend changed from bearish to bullish
+            if (prev_trend == -1 && current_trend == 1)
+            {
+                if (in_position_ && last_trend_ == -1)
+                {
+                    last_trend_ = current_trend;
+                    return Signal::EXIT_SHORT;
+                }
+                if (!in_position_)
+                {
+                    in_position_ = true;
+                    last_trend_ = current_trend;
+                    return Signal::LONG;
+                }
+            }
+
+            // Trend changed from bullish to bearish
+            if (prev_trend == 1 && current_trend == -1)
+            {
+                if (in_position_ && last_trend_ == 1)
+                {
+                    last_trend_ = current_trend;
+                    return Signal::EXIT_LONG;
+                }
+                if (!in_position_)
+                {
+                    in_position_ = true;
+                    last_trend_ = current_trend;
+                    return Signal::SHORT;
+                }
+            }
+
+            last_trend_ = current_trend;
+            return Signal::NONE;
+        }
+
+        inline bool SupertrendStrategy::isReady(size_t index) const
+        {
+            return supertrend_ && supertrend_->isReady(index);
+        }
+
     } // namespace strategy
 } // namespace backtest
 
@@ -0,0 +1,49 @@
+#ifndef STRING_DICTIONARY_H
+#define STRING_DICTIONARY_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace backtest
+{
+
+    // Interns repeated strings (dates, expiries, labels) into dense integer ids
+    class StringDictionary
+    {
+    public:
+        uint32_t intern(std::string_view text)
+        {
+            std::string value(text);
+            auto it = ids_.find(value);
+            if (it != ids_.end())
+            {
+                return it->second;
+            }
+
+            uint32_t id = static_cast<uint32_t>(values_.size());
+            values_.push_back(value);
+            ids_.emplace(value, id);
+            return id;
+        }
+
+        const std::string &lookup(uint32_t id) const { return values_[id]; }
+
+        size_t size() const { return values_.size(); }
+
+        void clear()
+        {
+            values_.clear();
+            ids_.clear();
+        }
+
+    private:
+        std::vector<std::string> values_;
+        std::unordered_map<std::string, uint32_t> ids_;
+    };
+
+} // namespace backtest
+
+#endif // STRING_DICTIONARY_H
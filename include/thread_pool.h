@@ -0,0 +1,101 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace backtest
+{
+
+    // Work-stealing task scheduler. Each worker owns a deque: it pops its own
+    // newest job first and, when empty, steals the oldest job from a peer, so
+    // long-running jobs do not leave other cores idle at the tail of a batch.
+    class WorkStealingPool
+    {
+    public:
+        struct JobTiming
+        {
+            size_t job_id;      // submission order since construction
+            size_t worker;      // worker that ran the job
+            double start_ms;    // relative to pool construction
+            double duration_ms;
+        };
+
+        struct WorkerStats
+        {
+            size_t jobs;
+            size_t steals;
+            double busy_ms;
+        };
+
+        // num_threads = 0 uses hardware_concurrency(); pin_threads binds
+        // worker i to CPU i (Linux only, ignored elsewhere)
+        explicit WorkStealingPool(size_t num_threads = 0, bool pin_threads = false);
+        ~WorkStealingPool();
+
+        WorkStealingPool(const WorkStealingPool &) = delete;
+        WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+        // Queue a job; returns its job id
+        size_t submit(std::function<void()> job);
+
+        // Block until every submitted job has finished. Rethrows the first
+        // exception raised by a job since the last wait().
+        void wait();
+
+        size_t size() const { return workers_.size(); }
+
+        // Index of the calling worker thread in [0, size()), or kNotWorker
+        // when called from a thread that does not belong to this pool
+        static constexpr size_t kNotWorker = SIZE_MAX;
+        size_t workerIndex() const;
+
+        std::vector<JobTiming> getJobTimings() const;
+        std::vector<WorkerStats> getWorkerStats() const;
+
+    private:
+        struct Task
+        {
+            size_t id;
+            std::function<void()> fn;
+        };
+
+        struct Worker
+        {
+            std::thread thread;
+            std::deque<Task> queue;
+            mutable std::mutex mutex;
+            std::vector<JobTiming> timings;
+            WorkerStats stats;
+        };
+
+        void workerLoop(size_t index);
+        bool popLocal(size_t index, Task &task);
+        bool steal(size_t thief, Task &task);
+        void run(size_t index, Task &task, bool stolen);
+
+        std::vector<std::unique_ptr<Worker>> workers_;
+        std::chrono::steady_clock::time_point epoch_;
+
+        std::mutex state_mutex_;
+        std::condition_variable work_available_;
+        std::condition_variable all_done_;
+        std::atomic<size_t> queued_;
+        size_t unfinished_;
+        size_t next_job_id_;
+        bool stopping_;
+        std::exception_ptr first_error_;
+    };
+
+} // namespace backtest
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,29 @@
+#ifndef TIME_UTILS_H
+#define TIME_UTILS_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace backtest
+{
+
+    constexpr int64_t kNanosPerSecond = 1000000000LL;
+    constexpr int64_t kSecondsPerDay = 86400;
+
+    // Days since 1970-01-01 for a proleptic Gregorian date
+    int64_t daysFromCivil(int year, int month, int day);
+
+    // Parse a calendar date, "DD-MM-YYYY" or "YYYY-MM-DD", into days since 1970-01-01
+    bool parseDate(std::string_view text, int64_t &days);
+
+    // Parse "YYYY-MM-DD HH:MM:SS[+HH:MM]" into UTC epoch nanoseconds.
+    // utc_offset_seconds receives the zone offset (0 when absent).
+    bool parseTimestamp(std::string_view text, int64_t &epoch_ns, int &utc_offset_seconds);
+
+    // Format epoch nanoseconds back to "YYYY-MM-DD HH:MM:SS+HH:MM" in the given offset
+    std::string formatTimestamp(int64_t epoch_ns, int utc_offset_seconds);
+
+} // namespace backtest
+
+#endif // TIME_UTILS_H
@@ -2,6 +2,8 @@
 #define TRADE_LOGGER_H
 
 #include "data_structures.h"
+#include "bar_series.h"
+#include "string_dictionary.h"
 #include <vector>
 #include <string>
 #include <mutex>
@@ -12,12 +14,26 @@ class TradeLogger {
 public:
     TradeLogger();
     
+    // Series the logged trades' bar indices refer to; must outlive export
+    void setBarSeries(const BarSeries* bars) { bars_ = bars; }
+    const BarSeries* getBarSeries() const { return bars_; }
+    
+    // Id for a strategy/parameters pair, interned once per run
+    uint32_t internRun(const std::string& strategy_name, const std::string& parameters);
+    
     // Add trade to buffer
     void logTrade(const Trade& trade);
     
+    // Runs that only need metrics can drop trades instead of buffering them
+    void setKeepTrades(bool keep_trades) { keep_trades_ = keep_trades; }
+    bool keepsTrades() const { return keep_trades_; }
+    
     // Get all trades
     const std::vector<Trade>& getTrades() const { return trades_; }
     
+    // Text form of a logged trade (export/display only)
+    TradeRecord materialize(const Trade& trade) const;
+    
     // Save trades to Parquet file
     bool saveToParquet(const std::string& filepath);
     
@@ -30,6 +46,10 @@ public:
 private:
     std::vector<Trade> trades_;
     std::mutex mutex_;
+    const BarSeries* bars_;
+    bool keep_trades_;
+    StringDictionary run_parameters_;
+    std::vector<std::string> run_strategies_;
 };
 
 } // namespace backtest
@@ -0,0 +1,99 @@
+#ifndef TRADE_WRITER_H
+#define TRADE_WRITER_H
+
+#include "trade_logger.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace backtest
+{
+
+    // Background writer that collects the trades of many backtests into one
+    // Parquet dataset. Backtest threads hand over a finished TradeLogger
+    // tagged with the run's param_id and continue; a dedicated I/O thread
+    // materializes the trades and buffers them per (strategy, DTE)
+    // partition, writing each partition out as its own row groups so readers
+    // can prune by strategy or DTE from the row group statistics. The queue
+    // is bounded, so producers that outrun the disk block in submit()
+    // instead of holding every pending log in memory.
+    class TradeWriter
+    {
+    public:
+        struct Stats
+        {
+            size_t batches;    // logs consumed
+            size_t trades;
+            size_t row_groups;
+            size_t failures;   // batches or row groups that could not be written
+            double blocked_ms; // total time producers waited on a full queue
+        };
+
+        explicit TradeWriter(const std::string &filepath, size_t capacity = 64, size_t row_group_rows = 65536);
+
+        // Closes the dataset if close() was not called
+        ~TradeWriter();
+
+        TradeWriter(const TradeWriter &) = delete;
+        TradeWriter &operator=(const TradeWriter &) = delete;
+
+        // Queue the trades of `logger` under `param_id`. Blocks while
+        // `capacity` logs are already waiting. The BarSeries the logger
+        // refers to must outlive the write (call flush() before releasing it).
+        void submit(std::unique_ptr<TradeLogger> logger, uint32_t param_id);
+
+        // Block until every submitted log has been consumed (rows may still
+        // be buffered in partitions until close())
+        void flush();
+
+        // Write out every partition, finish the file and stop the I/O
+        // thread. Returns false if the file could not be written.
+        bool close();
+
+        const std::string &getPath() const { return filepath_; }
+        Stats getStats() const;
+
+    private:
+        struct Batch
+        {
+            std::unique_ptr<TradeLogger> logger;
+            uint32_t param_id;
+        };
+
+        struct Partition;
+        struct Output;
+
+        void ioLoop();
+        void consume(Batch &batch);
+        void writePartition(Partition &partition);
+
+        std::string filepath_;
+        size_t capacity_;
+        size_t row_group_rows_;
+
+        std::unique_ptr<Output> output_; // I/O thread only
+        std::map<std::pair<std::string, int>, std::unique_ptr<Partition>> partitions_; // I/O thread only
+
+        std::thread thread_;
+        std::deque<Batch> queue_;
+        size_t in_flight_;
+        bool stopping_;
+        bool closed_;
+        bool ok_;
+        Stats stats_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable not_empty_;
+        std::condition_variable not_full_;
+        std::condition_variable idle_;
+    };
+
+} // namespace backtest
+
+#endif // TRADE_WRITER_H
@@ -0,0 +1,64 @@
+#ifndef TRADING_CALENDAR_H
+#define TRADING_CALENDAR_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace backtest
+{
+
+    // Maps (date, expiry) to days-to-expiry. Each distinct date string is
+    // parsed once and each distinct (date, expiry) pair computed once, so
+    // filling a DTE column costs a table lookup per run of equal dates.
+    // Copies carry their tables along; give each thread its own copy.
+    class TradingCalendar
+    {
+    public:
+        enum class DTEMode
+        {
+            CalendarDays, // calendar days to expiry + 1, clamped to 1-5
+            TradingDays   // trading days (weekdays, not holidays) up to expiry + 1
+        };
+
+        explicit TradingCalendar(DTEMode mode = DTEMode::CalendarDays);
+
+        DTEMode getMode() const { return mode_; }
+        void setMode(DTEMode mode);
+
+        void addHoliday(int64_t day);
+
+        // One date per line (DD-MM-YYYY or YYYY-MM-DD); '#' starts a comment
+        bool loadHolidays(const std::string &path);
+
+        bool isTradingDay(int64_t day) const;
+        size_t holidayCount() const { return holidays_.size(); }
+
+        // Identifies the DTE this calendar produces: "calendar", or
+        // "trading" with a hash of the holiday set
+        std::string fingerprint() const;
+
+        // DTE for a bar on `date` whose weekly expiry is `expiry`; unparsable
+        // dates give 1, the floor of the legacy clamp
+        int dte(std::string_view date, std::string_view expiry);
+        int dte(int64_t day, int64_t expiry_day) const;
+
+    private:
+        bool dayOf(std::string_view date, int64_t &day);
+
+        DTEMode mode_;
+        std::unordered_set<int64_t> holidays_;
+        std::unordered_map<std::string, int64_t> days_;
+        std::unordered_map<uint64_t, int> table_;
+
+        // Rows arrive in runs of the same pair; skip hashing for repeats
+        std::string last_date_;
+        std::string last_expiry_;
+        int last_dte_;
+    };
+
+} // namespace backtest
+
+#endif // TRADING_CALENDAR_H
@@ -1,18 +1,27 @@
 #include "backtest_engine.h"
 #include "strategy/ema_crossover.h"
 #include "strategy/supertrend_strategy.h"
+#include "indicators/ema_bank.h"
+#include "trade_writer.h"
+#include "results_index.h"
+#include <atomic>
+#include <cmath>
+#include <cstring>
 #include <thread>
-#include <future>
 #include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
+#include <map>
 
 namespace backtest
 {
 
     BacktestEngine::BacktestEngine(double initial_capital)
-        : initial_capital_(initial_capital) {}
+        : initial_capital_(initial_capital), num_threads_(0), pin_threads_(false), event_driven_(true),
+          metrics_only_(false), top_k_(0),
+          top_results_(10), keep_all_results_(true), halving_rungs_(0), halving_eta_(3.0),
+          session_index_series_(0), session_index_size_(0) {}
 
     std::unique_ptr<strategy::StrategyBase> BacktestEngine::createStrategy(const std::string &name)
     {
@@ -27,335 +36,483 @@ namespace backtest
         return nullptr;
     }
 
-    bool BacktestEngine::isWithinTradingHours(const std::string &timestamp) const
+    void BacktestEngine::setSessionCalendar(const SessionCalendar &calendar)
     {
-        // Extract time from timestamp (format: YYYY-MM-DD HH:MM:SS+05:30)
-        size_t space_pos = timestamp.find(' ');
-        if (space_pos == std::string::npos)
-            return false;
-
-        std::string time_str = timestamp.substr(space_pos + 1, 5); // HH:MM
-        int hour = std::stoi(time_str.substr(0, 2));
-        int minute = std::stoi(time_str.substr(3, 2));
-
-        int time_minutes = hour * 60 + minute;
-        int start_time = 9 * 60 + 15; // 09:15
-        int end_time = 15 * 60 + 25;  // 15:25
-
-        return time_minutes >= start_time && time_minutes <= end_time;
+        session_ = calendar;
+        std::lock_guard<std::mutex> lock(session_index_mutex_);
+        session_index_.reset();
     }
 
-    bool BacktestEngine::shouldSquareOff(const std::string &timestamp) const
+    std::shared_ptr<const SessionIndex> BacktestEngine::getSessionIndex(const BarSeries &bars)
     {
-        size_t space_pos = timestamp.find(' ');
-        if (space_pos == std::string::npos)
-            return false;
-
-        std::string time_str = timestamp.substr(space_pos + 1, 5);
-        int hour = std::stoi(time_str.substr(0, 2));
-        int minute = std::stoi(time_str.substr(3, 2));
-
-        int time_minutes = hour * 60 + minute;
-        int square_off_time = 15 * 60 + 25; // 15:25
-
-        return time_minutes >= square_off_time;
+        // Every parameter set of an optimization runs on the same series, so
+        // the index is built once and shared across worker threads
+        std::lock_guard<std::mutex> lock(session_index_mutex_);
+        if (!session_index_ || session_index_series_ != bars.id() || session_index_size_ != bars.size())
+        {
+            session_index_ = std::make_shared<const SessionIndex>(bars, session_);
+            session_index_series_ = bars.id();
+            session_index_size_ = bars.size();
+        }
+        return session_index_;
     }
 
-    PerformanceMetrics BacktestEngine::runBacktest(
-        const std::vector<Bar> &bars,
-        strategy::StrategyBase *strategy,
-        const StrategyParams &params,
-        TradeLogger &logger)
+    void BacktestEngine::collectEvents(const std::vector<int8_t> &events, std::vector<uint32_t> &event_bars)
     {
-        // Initialize strategy
-        strategy->initialize(params);
-        strategy->calculateIndicators(bars);
-
-        // Trading state
-        bool in_position = false;
-        Trade current_trade;
-        double quantity = 0.0;
-
-        // Iterate through bars
-        for (size_t i = 0; i < bars.size(); ++i)
+        // Signals are sparse; test eight bars per load and only look inside
+        // words that contain one
+        event_bars.clear();
+        size_t n = events.size();
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
         {
-            const Bar &bar = bars[i];
-
-            // Check DTE filter
-            if (params.dte_filter != -1 && bar.dte != params.dte_filter)
+            uint64_t word;
+            std::memcpy(&word, events.data() + i, sizeof(word));
+            if (word == 0)
             {
-                // Square off if we're in position and DTE changed
-                if (in_position && shouldSquareOff(bar.timestamp))
+                continue;
+            }
+            for (size_t j = i; j < i + 8; ++j)
+            {
+                if (events[j] != 0)
                 {
-                    current_trade.exit_time = bar.timestamp;
-                    current_trade.exit_date = bar.date;
-                    current_trade.exit_price = bar.close;
-
-                    if (current_trade.direction == "LONG")
-                    {
-                        current_trade.pnl = (current_trade.exit_price - current_trade.entry_price) * quantity;
-                    }
-                    else
-                    {
-                        current_trade.pnl = (current_trade.entry_price - current_trade.exit_price) * quantity;
-                    }
-                    current_trade.pnl_percentage = (current_trade.pnl / (current_trade.entry_price * quantity)) * 100.0;
-
-                    logger.logTrade(current_trade);
-                    in_position = false;
+                    event_bars.push_back(static_cast<uint32_t>(j));
                 }
-                continue;
             }
-
-            // Skip if not in trading hours
-            if (!isWithinTradingHours(bar.timestamp))
+        }
+        for (; i < n; ++i)
+        {
+            if (events[i] != 0)
             {
-                continue;
+                event_bars.push_back(static_cast<uint32_t>(i));
             }
+        }
+    }
 
-            // Square off at end of day
-            if (in_position && shouldSquareOff(bar.timestamp))
-            {
-                current_trade.exit_time = bar.timestamp;
-                current_trade.exit_date = bar.date;
-                current_trade.exit_price = bar.close;
+    void BacktestEngine::setThreadCount(size_t num_threads)
+    {
+        num_threads_ = num_threads;
+    }
 
-                if (current_trade.direction == "LONG")
-                {
-                    current_trade.pnl = (current_trade.exit_price - current_trade.entry_price) * quantity;
-                }
-                else
-                {
-                    current_trade.pnl = (current_trade.entry_price - current_trade.exit_price) * quantity;
-                }
-                current_trade.pnl_percentage = (current_trade.pnl / (current_trade.entry_price * quantity)) * 100.0;
+    void BacktestEngine::setPinThreads(bool pin_threads)
+    {
+        pin_threads_ = pin_threads;
+    }
 
-                logger.logTrade(current_trade);
-                in_position = false;
-                continue;
-            }
+    void BacktestEngine::printTopResults(const ResultCollector &results) const
+    {
+        if (top_results_ == 0)
+        {
+            return;
+        }
 
-            // Generate signal
-            if (!strategy->isReady(i))
+        for (size_t o = 0; o < static_cast<size_t>(ResultCollector::Objective::Count); ++o)
+        {
+            auto objective = static_cast<ResultCollector::Objective>(o);
+            std::vector<PerformanceMetrics> best = results.top(objective);
+            best.resize(std::min(best.size(), top_results_));
+
+            std::cout << "\n=== Top " << best.size() << " by " << ResultCollector::name(objective) << " ===" << std::endl;
+            for (const auto &metrics : best)
             {
-                continue;
+                std::cout << "  " << std::left << std::setw(32) << metrics.strategy_params << std::right
+                          << " score " << std::fixed << std::setprecision(3)
+                          << std::setw(10) << ResultCollector::score(metrics, objective)
+                          << " | Trades: " << metrics.total_trades
+                          << " | PnL: " << std::setprecision(2) << metrics.total_pnl
+                          << " | DD: " << metrics.max_drawdown << "%" << std::endl;
             }
+        }
+    }
+
+    void BacktestEngine::printLoadBalance(const WorkStealingPool &pool) const
+    {
+        std::vector<WorkStealingPool::WorkerStats> workers = pool.getWorkerStats();
+        std::vector<WorkStealingPool::JobTiming> timings = pool.getJobTimings();
+        if (timings.empty())
+        {
+            return;
+        }
 
-            strategy::Signal signal = strategy->generateSignal(i, bars);
+        double total_ms = 0.0, slowest_ms = 0.0;
+        for (const auto &timing : timings)
+        {
+            total_ms += timing.duration_ms;
+            slowest_ms = std::max(slowest_ms, timing.duration_ms);
+        }
 
-            // Handle signals
-            if (signal == strategy::Signal::LONG && !in_position)
+        std::cout << "\n=== Load Balance ===" << std::endl;
+        std::cout << std::fixed << std::setprecision(1)
+                  << "Jobs: " << timings.size()
+                  << " | Avg: " << total_ms / timings.size() << " ms"
+                  << " | Slowest: " << slowest_ms << " ms" << std::endl;
+        for (size_t w = 0; w < workers.size(); ++w)
+        {
+            std::cout << "Worker " << w << ": " << workers[w].jobs << " jobs, "
+                      << workers[w].steals << " stolen, "
+                      << workers[w].busy_ms << " ms busy" << std::endl;
+        }
+    }
+
+    void BacktestEngine::precomputeEMAs(const BarSeries &bars,
+                                        const std::vector<StrategyParams> &param_combinations)
+    {
+        std::vector<int> periods;
+        for (const auto &params : param_combinations)
+        {
+            auto strategy = createStrategy(params.strategy_name);
+            if (!strategy)
             {
-                in_position = true;
-                quantity = std::floor(initial_capital_ / bar.close);
-
-                current_trade = Trade();
-                current_trade.entry_time = bar.timestamp;
-                current_trade.entry_date = bar.date;
-                current_trade.entry_price = bar.close;
-                current_trade.quantity = quantity;
-                current_trade.direction = "LONG";
-                current_trade.dte = bar.dte;
-                current_trade.strategy_name = strategy->getName();
-                current_trade.parameters = params.to_string();
+                continue;
             }
-            else if (signal == strategy::Signal::SHORT && !in_position)
+
+            try
             {
-                in_position = true;
-                quantity = std::floor(initial_capital_ / bar.close);
-
-                current_trade = Trade();
-                current_trade.entry_time = bar.timestamp;
-                current_trade.entry_date = bar.date;
-                current_trade.entry_price = bar.close;
-                current_trade.quantity = quantity;
-                current_trade.direction = "SHORT";
-                current_trade.dte = bar.dte;
-                current_trade.strategy_name = strategy->getName();
-                current_trade.parameters = params.to_string();
+                strategy->initialize(params);
             }
-            else if ((signal == strategy::Signal::EXIT_LONG || signal == strategy::Signal::EXIT_SHORT) && in_position)
+            catch (const std::exception &)
             {
-                current_trade.exit_time = bar.timestamp;
-                current_trade.exit_date = bar.date;
-                current_trade.exit_price = bar.close;
+                continue; // reported when the job itself runs
+            }
 
-                if (current_trade.direction == "LONG")
-                {
-                    current_trade.pnl = (current_trade.exit_price - current_trade.entry_price) * quantity;
-                }
-                else
+            for (int period : strategy->getEMAPeriods())
+            {
+                if (!indicator_cache_.contains<indicators::EMA>(bars, period))
                 {
-                    current_trade.pnl = (current_trade.entry_price - current_trade.exit_price) * quantity;
+                    periods.push_back(period);
                 }
-                current_trade.pnl_percentage = (current_trade.pnl / (current_trade.entry_price * quantity)) * 100.0;
-
-                logger.logTrade(current_trade);
-                in_position = false;
             }
         }
 
-        // Calculate and return metrics
-        return calculateMetrics(logger.getTrades(), params, params.dte_filter);
+        if (periods.empty())
+        {
+            return;
+        }
+
+        indicators::EMABank bank(periods);
+        bank.calculate(bars);
+        bank.publish(indicator_cache_, bars);
+
+        std::cout << "Precomputed " << bank.getPeriods().size() << " EMA series in one pass" << std::endl;
     }
 
-    PerformanceMetrics BacktestEngine::calculateMetrics(
-        const std::vector<Trade> &trades,
+    PerformanceMetrics BacktestEngine::runBacktest(
+        const BarSeries &bars,
+        strategy::StrategyBase *strategy,
         const StrategyParams &params,
-        int dte_filter)
+        TradeLogger &logger)
     {
-        PerformanceMetrics metrics;
-        metrics.strategy_params = params.to_string();
-        metrics.dte = dte_filter;
-
-        if (trades.empty())
+        // One type check per run picks the loop compiled for each strategy
+        // createStrategy() can build; anything else runs through virtual calls
+        if (auto *ema = dynamic_cast<strategy::EMACrossover *>(strategy))
         {
-            return metrics;
+            return runBacktest(bars, ema, params, logger);
         }
+        if (auto *supertrend = dynamic_cast<strategy::SupertrendStrategy *>(strategy))
+        {
+            return runBacktest(bars, supertrend, params, logger);
+        }
+        return runBacktest<strategy::StrategyBase>(bars, strategy, params, logger);
+    }
 
-        double total_wins = 0.0;
-        double total_losses = 0.0;
-        int current_wins = 0, current_losses = 0;
-
-        for (const auto &trade : trades)
+    std::vector<PerformanceMetrics> BacktestEngine::runBacktestDTEs(
+        const BarSeries &bars,
+        const StrategyParams &params,
+        const std::vector<int> &dte_filters,
+        const std::vector<TradeLogger *> &loggers,
+        size_t end_bar)
+    {
+        if (params.strategy_name == "EMA_Crossover")
+        {
+            return runBacktestDTEs<strategy::EMACrossover>(bars, params, dte_filters, loggers, end_bar);
+        }
+        if (params.strategy_name == "Supertrend")
         {
-            metrics.total_trades++;
-            metrics.total_pnl += trade.pnl;
+            return runBacktestDTEs<strategy::SupertrendStrategy>(bars, params, dte_filters, loggers, end_bar);
+        }
+        return {};
+    }
 
-            if (trade.pnl > 0)
+    std::vector<PerformanceMetrics> BacktestEngine::runOptimization(
+        const BarSeries &bars,
+        const std::string &strategy_name,
+        const std::vector<StrategyParams> &param_combinations,
+        const std::string &output_dir)
+    {
+        std::cout << "\n=== Running Optimization ===" << std::endl;
+        std::cout << "Strategy: " << strategy_name << std::endl;
+        std::cout << "Parameter combinations: " << param_combinations.size() << std::endl;
+        std::cout << "Using " << (num_threads_ ? num_threads_ : std::thread::hardware_concurrency())
+                  << " threads" << (pin_threads_ ? " (pinned)" : "") << std::endl;
+        if (metrics_only_)
+        {
+            std::cout << "Metrics only";
+            if (top_k_ > 0)
             {
-                metrics.winning_trades++;
-                total_wins += trade.pnl;
-                metrics.max_win = std::max(metrics.max_win, trade.pnl);
-                current_wins++;
-                current_losses = 0;
-                metrics.consecutive_wins = std::max(metrics.consecutive_wins, current_wins);
+                std::cout << ", trade logs for the top " << top_k_ << " by PnL";
             }
-            else
+            std::cout << std::endl;
+        }
+        if (prune_rules_.enabled())
+        {
+            std::cout << "Pruning runs with";
+            if (prune_rules_.max_drawdown_pct > 0)
             {
-                metrics.losing_trades++;
-                total_losses += std::abs(trade.pnl);
-                metrics.max_loss = std::min(metrics.max_loss, trade.pnl);
-                current_losses++;
-                current_wins = 0;
-                metrics.consecutive_losses = std::max(metrics.consecutive_losses, current_losses);
+                std::cout << " drawdown > " << prune_rules_.max_drawdown_pct << "%";
             }
+            if (prune_rules_.min_equity > 0)
+            {
+                std::cout << " equity < " << prune_rules_.min_equity;
+            }
+            if (prune_rules_.min_trades_by_midpoint > 0)
+            {
+                std::cout << " trades at midpoint < " << prune_rules_.min_trades_by_midpoint;
+            }
+            std::cout << std::endl;
         }
+        std::cout << std::endl;
 
-        metrics.total_return_pct = (metrics.total_pnl / initial_capital_) * 100.0;
-        metrics.win_rate = (static_cast<double>(metrics.winning_trades) / metrics.total_trades) * 100.0;
-
-        if (metrics.winning_trades > 0)
+        // Trade logs are encoded and written off the backtest threads, into
+        // one dataset partitioned by strategy and DTE. Metrics-only sweeps
+        // only need it for the top-K re-run.
+        std::unique_ptr<TradeWriter> writer;
+        if (!metrics_only_ || top_k_ > 0)
         {
-            metrics.avg_win = total_wins / metrics.winning_trades;
+            writer = std::make_unique<TradeWriter>(output_dir + "/trades.parquet");
         }
-        if (metrics.losing_trades > 0)
+        TradeWriter *sweep_writer = metrics_only_ ? nullptr : writer.get();
+
+        // Combinations that differ only in DTE filter share one pass
+        auto groupByParams = [&](const std::vector<size_t> &indices)
         {
-            metrics.avg_loss = total_losses / metrics.losing_trades;
-        }
+            std::vector<std::vector<size_t>> groups;
+            std::map<std::pair<std::string, std::vector<double>>, size_t> group_of;
+            for (size_t i : indices)
+            {
+                const StrategyParams &params = param_combinations[i];
+                auto inserted = group_of.emplace(std::make_pair(params.strategy_name, params.params), groups.size());
+                if (inserted.second)
+                {
+                    groups.emplace_back();
+                }
+                groups[inserted.first->second].push_back(i);
+            }
+            return groups;
+        };
 
-        if (total_losses > 0)
+        // Backtest one group on the bars before `end`; trades go to
+        // `trade_writer`, or are dropped as they close when it is null
+        auto runGroup = [&](const std::vector<size_t> &group, TradeWriter *trade_writer, size_t end)
         {
-            metrics.profit_factor = total_wins / total_losses;
-        }
+            const StrategyParams &first = param_combinations[group.front()];
 
-        metrics.expectancy = (metrics.win_rate / 100.0) * metrics.avg_win -
-                             ((100.0 - metrics.win_rate) / 100.0) * metrics.avg_loss;
+            std::vector<int> dte_filters;
+            std::vector<std::unique_ptr<TradeLogger>> owned_loggers;
+            std::vector<TradeLogger *> loggers;
+            for (size_t index : group)
+            {
+                dte_filters.push_back(param_combinations[index].dte_filter);
+                owned_loggers.push_back(std::make_unique<TradeLogger>());
+                owned_loggers.back()->setKeepTrades(trade_writer != nullptr);
+                loggers.push_back(owned_loggers.back().get());
+            }
 
-        // Calculate max drawdown
-        double peak = initial_capital_;
-        double current_capital = initial_capital_;
-        double max_dd = 0.0;
+            std::vector<PerformanceMetrics> metrics = runBacktestDTEs(bars, first, dte_filters, loggers, end);
+            if (metrics.empty())
+            {
+                std::cerr << "Unknown strategy: " << first.strategy_name << std::endl;
+                return metrics;
+            }
 
-        for (const auto &trade : trades)
-        {
-            current_capital += trade.pnl;
-            if (current_capital > peak)
+            for (size_t k = 0; k < group.size(); ++k)
             {
-                peak = current_capital;
+                uint32_t param_id = static_cast<uint32_t>(group[k]);
+                metrics[k].param_id = param_id;
+
+                // Save trades in the background
+                if (trade_writer)
+                {
+                    trade_writer->submit(std::move(owned_loggers[k]), param_id);
+                }
             }
-            double dd = ((peak - current_capital) / peak) * 100.0;
-            max_dd = std::max(max_dd, dd);
-        }
-        metrics.max_drawdown = max_dd;
+            return metrics;
+        };
 
-        return metrics;
-    }
+        precomputeEMAs(bars, param_combinations);
 
-    std::vector<PerformanceMetrics> BacktestEngine::runOptimization(
-        const std::vector<Bar> &bars,
-        const std::string &strategy_name,
-        const std::vector<StrategyParams> &param_combinations,
-        const std::string &output_dir)
-    {
-        std::cout << "\n=== Running Optimization ===" << std::endl;
-        std::cout << "Strategy: " << strategy_name << std::endl;
-        std::cout << "Parameter combinations: " << param_combinations.size() << std::endl;
-        std::cout << "Using " << std::thread::hardware_concurrency() << " threads\n"
-                  << std::endl;
+        std::vector<size_t> all_indices(param_combinations.size());
+        for (size_t i = 0; i < all_indices.size(); ++i)
+        {
+            all_indices[i] = i;
+        }
 
-        std::vector<PerformanceMetrics> all_metrics;
-        std::mutex metrics_mutex;
+        WorkStealingPool pool(num_threads_, pin_threads_);
 
-        // Worker function for each thread
-        auto worker = [&](const StrategyParams &params)
+        // Each worker records into its own shard; nothing is shared per job
+        // except the progress counter
+        const size_t top_k = std::max(top_results_, metrics_only_ ? top_k_ : 0);
+        ResultCollector results(pool.size(), top_k, keep_all_results_);
+
+        // Successive halving: rate every candidate on a prefix of the bars
+        // and keep only the best 1/eta for the next, eta times longer,
+        // prefix. Dropped combinations keep the metrics of their last rung.
+        std::vector<size_t> candidates = all_indices;
+        std::vector<PerformanceMetrics> dropped;
+        const size_t min_survivors = std::max<size_t>(1, top_k);
+        for (size_t rung = 0; rung + 1 < halving_rungs_ && candidates.size() > min_survivors; ++rung)
         {
-            auto strategy = createStrategy(strategy_name);
-            if (!strategy)
+            size_t end = static_cast<size_t>(
+                static_cast<double>(bars.size()) /
+                std::pow(halving_eta_, static_cast<double>(halving_rungs_ - 1 - rung)));
+
+            ResultCollector rung_results(pool.size(), 0);
+            const std::vector<std::vector<size_t>> rung_groups = groupByParams(candidates);
+            for (const auto &group : rung_groups)
+            {
+                pool.submit([&runGroup, &rung_results, &pool, &group, end]()
+                            {
+                                for (const PerformanceMetrics &metrics : runGroup(group, nullptr, end))
+                                {
+                                    rung_results.add(pool.workerIndex(), metrics);
+                                }
+                            });
+            }
+            pool.wait();
+
+            // Best return first; runs stopped by the rules rank last
+            std::vector<PerformanceMetrics> ranked = rung_results.takeAll();
+            std::sort(ranked.begin(), ranked.end(), [](const PerformanceMetrics &a, const PerformanceMetrics &b)
+                      {
+                          if (a.pruned() != b.pruned())
+                          {
+                              return b.pruned();
+                          }
+                          if (a.total_return_pct != b.total_return_pct)
+                          {
+                              return a.total_return_pct > b.total_return_pct;
+                          }
+                          return a.param_id < b.param_id;
+                      });
+            size_t keep = std::max(min_survivors,
+                                   static_cast<size_t>(std::ceil(static_cast<double>(ranked.size()) / halving_eta_)));
+
+            candidates.clear();
+            for (size_t r = 0; r < ranked.size(); ++r)
             {
-                std::cerr << "Unknown strategy: " << strategy_name << std::endl;
-                return;
+                if (r < keep && !ranked[r].pruned())
+                {
+                    candidates.push_back(ranked[r].param_id);
+                }
+                else
+                {
+                    // A rule that stopped the run is the more specific reason
+                    if (!ranked[r].pruned())
+                    {
+                        ranked[r].prune_reason = PruneReason::Halving;
+                    }
+                    ranked[r].halving_rung = static_cast<uint32_t>(rung + 1);
+                    dropped.push_back(ranked[r]);
+                }
             }
+            std::sort(candidates.begin(), candidates.end());
 
-            TradeLogger logger;
-            PerformanceMetrics metrics = runBacktest(bars, strategy.get(), params, logger);
+            std::cout << "Halving rung " << rung + 1 << ": " << ranked.size() << " candidates on the first "
+                      << end << " bars -> " << candidates.size() << " kept" << std::endl;
+        }
 
-            // Save trades to parquet
-            std::string filename = output_dir + "/trades_" + params.to_string() + ".parquet";
-            logger.saveToParquet(filename);
+        const std::vector<std::vector<size_t>> groups = groupByParams(candidates);
+        std::atomic<size_t> completed(0);
+        const size_t progress_step = std::max<size_t>(1, groups.size() / 20);
 
-            // Add metrics
+        // Worker function for each thread
+        auto worker = [&](const std::vector<size_t> &group)
+        {
+            size_t shard = pool.workerIndex();
+            for (const PerformanceMetrics &metrics : runGroup(group, sweep_writer, SIZE_MAX))
             {
-                std::lock_guard<std::mutex> lock(metrics_mutex);
-                all_metrics.push_back(metrics);
+                results.add(shard, metrics);
+            }
 
-                // Progress indicator
-                std::cout << "Completed: " << params.to_string()
-                          << " | Trades: " << metrics.total_trades
-                          << " | PnL: " << std::fixed << std::setprecision(2) << metrics.total_pnl
-                          << " | Return: " << metrics.total_return_pct << "%"
-                          << std::endl;
+            // Progress indicator, about every 5% of the sweep
+            size_t done = completed.fetch_add(1) + 1;
+            if (done % progress_step == 0 || done == groups.size())
+            {
+                std::ostringstream line;
+                line << "Completed " << done << "/" << groups.size() << " parameter groups\n";
+                std::cout << line.str() << std::flush;
             }
         };
 
-        // Launch threads
-        std::vector<std::thread> threads;
-        size_t num_threads = std::thread::hardware_concurrency();
-        size_t combinations_per_thread = (param_combinations.size() + num_threads - 1) / num_threads;
+        // Submit one job per parameter group; idle workers steal queued jobs
+        for (const auto &group : groups)
+        {
+            pool.submit([&worker, &group]()
+                        { worker(group); });
+        }
+        pool.wait();
+
+        printLoadBalance(pool);
 
-        for (size_t t = 0; t < num_threads; ++t)
+        // The pool is idle, so shard 0 is free for the halving drop-outs
+        for (const PerformanceMetrics &metrics : dropped)
         {
-            size_t start = t * combinations_per_thread;
-            size_t end = std::min(start + combinations_per_thread, param_combinations.size());
+            results.add(0, metrics);
+        }
 
-            if (start >= param_combinations.size())
-                break;
+        std::vector<PerformanceMetrics> all_metrics = keep_all_results_ ? results.takeAll() : results.topUnion();
 
-            threads.emplace_back([&, start, end]()
-                                 {
-            for (size_t i = start; i < end; ++i) {
-                worker(param_combinations[i]);
-            } });
+        // Metrics-only sweeps re-run just the best combinations for their trades
+        std::vector<std::vector<size_t>> top_groups;
+        if (metrics_only_ && top_k_ > 0)
+        {
+            std::vector<PerformanceMetrics> ranked = results.top(ResultCollector::Objective::Return);
+            size_t k = std::min(top_k_, ranked.size());
+
+            std::vector<size_t> top_indices;
+            for (size_t r = 0; r < k; ++r)
+            {
+                top_indices.push_back(ranked[r].param_id);
+            }
+            top_groups = groupByParams(top_indices);
+
+            std::cout << "\nRe-running top " << k << " parameter sets for trade logs..." << std::endl;
+            for (const auto &group : top_groups)
+            {
+                pool.submit([&runGroup, &group, &writer]()
+                            { runGroup(group, writer.get(), SIZE_MAX); });
+            }
+            pool.wait();
         }
 
-        // Wait for all threads
-        for (auto &thread : threads)
+        if (writer)
         {
-            thread.join();
+            writer->close();
+
+            TradeWriter::Stats writer_stats = writer->getStats();
+            std::cout << "Trade writer: " << writer_stats.trades << " trades from "
+                      << writer_stats.batches << " runs in "
+                      << writer_stats.row_groups << " row groups, "
+                      << writer_stats.failures << " failed, "
+                      << std::fixed << std::setprecision(1) << writer_stats.blocked_ms
+                      << " ms backpressure -> " << writer->getPath() << std::endl;
         }
+        ResultsIndex::save(all_metrics, param_combinations, output_dir + "/results_index.parquet");
+
+        printTopResults(results);
+
+        indicators::IndicatorCache::Stats cache_stats = indicator_cache_.getStats();
 
         std::cout << "\n=== Optimization Complete ===" << std::endl;
-        std::cout << "Total results: " << all_metrics.size() << std::endl;
+        std::cout << "Total results: " << results.count()
+                  << (keep_all_results_ ? "" : " (top results kept)") << std::endl;
+        if (results.prunedCount() > 0)
+        {
+            std::cout << "Pruned early: " << results.prunedCount() << std::endl;
+        }
+        std::cout << "Indicator cache: " << cache_stats.hits << " hits, "
+                  << cache_stats.misses << " misses, "
+                  << cache_stats.evictions << " evictions, "
+                  << cache_stats.bytes / (1024 * 1024) << " MB held" << std::endl;
 
         return all_metrics;
     }
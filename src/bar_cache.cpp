@@ -0,0 +1,307 @@
+#include "bar_cache.h"
+#include "mapped_file.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+namespace backtest
+{
+
+    namespace
+    {
+        constexpr char kMagic[8] = {'B', 'T', 'B', 'A', 'R', 'S', '\0', '\0'};
+        constexpr size_t kAlignment = 64;
+        constexpr size_t kSampleBytes = 64 * 1024;
+        constexpr size_t kColumnCount = 12;
+
+        // Column order and element widths of the on-disk layout
+        struct ColumnSpec
+        {
+            const char *name;
+            uint32_t width;
+        };
+
+        constexpr ColumnSpec kColumns[kColumnCount] = {
+            {"open:f64", 8}, {"high:f64", 8}, {"low:f64", 8}, {"close:f64", 8}, {"volume:f64", 8},
+            {"timestamp:i64", 8}, {"dte:i8", 1}, {"minute_of_day:i16", 2}, {"day_index:u32", 4},
+            {"date_id:u16", 2}, {"expiry_id:u16", 2}, {"dt_id:u16", 2}};
+
+        struct ColumnEntry
+        {
+            uint64_t offset;
+            uint64_t bytes;
+        };
+
+        struct Header
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t column_count;
+            uint64_t schema_hash;
+            uint64_t source_fingerprint;
+            uint64_t num_rows;
+            int64_t last_local_day;
+            int64_t utc_offset_seconds;
+            uint64_t dict_offset;
+            uint64_t dict_bytes;
+            ColumnEntry columns[kColumnCount];
+        };
+
+        constexpr uint64_t kFnvOffset = 14695981039346656037ULL;
+        constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+        uint64_t fnv1a(const void *data, size_t n, uint64_t hash = kFnvOffset)
+        {
+            const unsigned char *bytes = static_cast<const unsigned char *>(data);
+            for (size_t i = 0; i < n; ++i)
+            {
+                hash = (hash ^ bytes[i]) * kFnvPrime;
+            }
+            return hash;
+        }
+
+        template <typename T>
+        uint64_t mix(uint64_t hash, T value)
+        {
+            return fnv1a(&value, sizeof(value), hash);
+        }
+
+        // Changes whenever a column is added, reordered or retyped, or the
+        // header itself changes shape
+        uint64_t schemaHash()
+        {
+            uint64_t hash = mix(kFnvOffset, static_cast<uint64_t>(sizeof(Header)));
+            for (const ColumnSpec &spec : kColumns)
+            {
+                hash = fnv1a(spec.name, std::strlen(spec.name), hash);
+                hash = mix(hash, spec.width);
+            }
+            return hash;
+        }
+
+        uint64_t alignUp(uint64_t offset)
+        {
+            return (offset + kAlignment - 1) / kAlignment * kAlignment;
+        }
+
+        template <typename T>
+        const void *columnData(const Column<T> &column)
+        {
+            return column.data();
+        }
+
+        void writeDictionary(std::ofstream &out, const StringDictionary &dictionary)
+        {
+            uint32_t count = static_cast<uint32_t>(dictionary.size());
+            out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+            for (uint32_t id = 0; id < count; ++id)
+            {
+                const std::string &value = dictionary.lookup(id);
+                uint32_t length = static_cast<uint32_t>(value.size());
+                out.write(reinterpret_cast<const char *>(&length), sizeof(length));
+                out.write(value.data(), length);
+            }
+        }
+
+        bool readDictionary(const char *&cursor, const char *end, StringDictionary &dictionary)
+        {
+            uint32_t count = 0;
+            if (end - cursor < static_cast<ptrdiff_t>(sizeof(count)))
+            {
+                return false;
+            }
+            std::memcpy(&count, cursor, sizeof(count));
+            cursor += sizeof(count);
+
+            for (uint32_t id = 0; id < count; ++id)
+            {
+                uint32_t length = 0;
+                if (end - cursor < static_cast<ptrdiff_t>(sizeof(length)))
+                {
+                    return false;
+                }
+                std::memcpy(&length, cursor, sizeof(length));
+                cursor += sizeof(length);
+                if (end - cursor < static_cast<ptrdiff_t>(length))
+                {
+                    return false;
+                }
+                // Ids are positional, so every value must intern to its index
+                if (dictionary.intern(std::string_view(cursor, length)) != id)
+                {
+                    return false;
+                }
+                cursor += length;
+            }
+            return true;
+        }
+
+        template <typename T>
+        Column<T> mapColumn(const std::shared_ptr<MappedFile> &file, const ColumnEntry &entry)
+        {
+            return Column<T>::view(reinterpret_cast<const T *>(file->data() + entry.offset),
+                                   entry.bytes / sizeof(T), file);
+        }
+    } // namespace
+
+    uint64_t BarCache::fingerprint(const std::vector<std::string> &paths)
+    {
+        uint64_t hash = kFnvOffset;
+        for (const std::string &path : paths)
+        {
+            std::error_code error;
+            uint64_t size = std::filesystem::file_size(path, error);
+            if (error)
+            {
+                hash = mix(hash, ~0ULL);
+                continue;
+            }
+            auto modified = std::filesystem::last_write_time(path, error);
+            hash = mix(hash, size);
+            hash = mix(hash, static_cast<int64_t>(error ? 0 : modified.time_since_epoch().count()));
+
+            // Sampling both ends catches in-place rewrites that keep size and mtime
+            std::ifstream file(path, std::ios::binary);
+            std::string sample(static_cast<size_t>(std::min<uint64_t>(size, kSampleBytes)), '\0');
+            file.read(&sample[0], static_cast<std::streamsize>(sample.size()));
+            hash = fnv1a(sample.data(), static_cast<size_t>(file.gcount()), hash);
+            if (size > kSampleBytes)
+            {
+                file.clear();
+                file.seekg(static_cast<std::streamoff>(size - sample.size()));
+                file.read(&sample[0], static_cast<std::streamsize>(sample.size()));
+                hash = fnv1a(sample.data(), static_cast<size_t>(file.gcount()), hash);
+            }
+        }
+        return hash;
+    }
+
+    bool BarCache::save(const BarSeries &bars, const std::string &path, uint64_t source_fingerprint)
+    {
+        const void *columns[kColumnCount] = {
+            columnData(bars.open_), columnData(bars.high_), columnData(bars.low_),
+            columnData(bars.close_), columnData(bars.volume_), columnData(bars.timestamp_),
+            columnData(bars.dte_), columnData(bars.minute_of_day_), columnData(bars.day_index_),
+            columnData(bars.date_id_), columnData(bars.expiry_id_), columnData(bars.dt_id_)};
+
+        Header header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kVersion;
+        header.column_count = kColumnCount;
+        header.schema_hash = schemaHash();
+        header.source_fingerprint = source_fingerprint;
+        header.num_rows = bars.size();
+        header.last_local_day = bars.last_local_day_;
+        header.utc_offset_seconds = bars.utc_offset_seconds_;
+
+        uint64_t offset = alignUp(sizeof(Header));
+        for (size_t c = 0; c < kColumnCount; ++c)
+        {
+            header.columns[c].offset = offset;
+            header.columns[c].bytes = header.num_rows * kColumns[c].width;
+            offset = alignUp(offset + header.columns[c].bytes);
+        }
+        header.dict_offset = offset;
+
+        std::string temp_path = path + ".tmp";
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+        {
+            std::cerr << "Error: Cannot write bar cache: " << temp_path << std::endl;
+            return false;
+        }
+
+        const char padding[kAlignment] = {};
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        uint64_t written = sizeof(header);
+        for (size_t c = 0; c < kColumnCount; ++c)
+        {
+            out.write(padding, static_cast<std::streamsize>(header.columns[c].offset - written));
+            out.write(static_cast<const char *>(columns[c]), static_cast<std::streamsize>(header.columns[c].bytes));
+            written = header.columns[c].offset + header.columns[c].bytes;
+        }
+        out.write(padding, static_cast<std::streamsize>(header.dict_offset - written));
+        writeDictionary(out, bars.dates_);
+        writeDictionary(out, bars.labels_);
+
+        // Patch the dictionary size in now that it is known
+        header.dict_bytes = static_cast<uint64_t>(out.tellp()) - header.dict_offset;
+        out.seekp(0);
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.close();
+
+        std::error_code error;
+        if (!out || (std::filesystem::rename(temp_path, path, error), error))
+        {
+            std::cerr << "Error: Failed to write bar cache: " << path << std::endl;
+            std::filesystem::remove(temp_path, error);
+            return false;
+        }
+        return true;
+    }
+
+    bool BarCache::load(const std::string &path, uint64_t source_fingerprint, BarSeries &bars)
+    {
+        auto file = std::make_shared<MappedFile>();
+        if (!file->open(path) || file->size() < sizeof(Header))
+        {
+            return false;
+        }
+
+        Header header;
+        std::memcpy(&header, file->data(), sizeof(header));
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+            header.version != kVersion ||
+            header.column_count != kColumnCount ||
+            header.schema_hash != schemaHash() ||
+            header.source_fingerprint != source_fingerprint)
+        {
+            return false;
+        }
+
+        for (size_t c = 0; c < kColumnCount; ++c)
+        {
+            const ColumnEntry &entry = header.columns[c];
+            if (entry.offset % kAlignment != 0 ||
+                entry.bytes != header.num_rows * kColumns[c].width ||
+                entry.offset > file->size() || entry.bytes > file->size() - entry.offset)
+            {
+                return false;
+            }
+        }
+        if (header.dict_offset > file->size() || header.dict_bytes > file->size() - header.dict_offset)
+        {
+            return false;
+        }
+
+        BarSeries loaded;
+        const char *cursor = file->data() + header.dict_offset;
+        const char *end = cursor + header.dict_bytes;
+        if (!readDictionary(cursor, end, loaded.dates_) || !readDictionary(cursor, end, loaded.labels_))
+        {
+            return false;
+        }
+
+        loaded.open_ = mapColumn<double>(file, header.columns[0]);
+        loaded.high_ = mapColumn<double>(file, header.columns[1]);
+        loaded.low_ = mapColumn<double>(file, header.columns[2]);
+        loaded.close_ = mapColumn<double>(file, header.columns[3]);
+        loaded.volume_ = mapColumn<double>(file, header.columns[4]);
+        loaded.timestamp_ = mapColumn<int64_t>(file, header.columns[5]);
+        loaded.dte_ = mapColumn<int8_t>(file, header.columns[6]);
+        loaded.minute_of_day_ = mapColumn<int16_t>(file, header.columns[7]);
+        loaded.day_index_ = mapColumn<uint32_t>(file, header.columns[8]);
+        loaded.date_id_ = mapColumn<uint16_t>(file, header.columns[9]);
+        loaded.expiry_id_ = mapColumn<uint16_t>(file, header.columns[10]);
+        loaded.dt_id_ = mapColumn<uint16_t>(file, header.columns[11]);
+        loaded.last_local_day_ = header.last_local_day;
+        loaded.utc_offset_seconds_ = static_cast<int>(header.utc_offset_seconds);
+
+        bars = std::move(loaded);
+        return true;
+    }
+
+} // namespace backtest
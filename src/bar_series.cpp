@@ -0,0 +1,162 @@
+#include "bar_series.h"
+#include "time_utils.h"
+#include <atomic>
+
+namespace backtest
+{
+
+    uint64_t BarSeries::SeriesId::next()
+    {
+        static std::atomic<uint64_t> counter{1};
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    BarSeries::BarSeries() : utc_offset_seconds_(0), last_local_day_(0) {}
+
+    void BarSeries::reserve(size_t n)
+    {
+        open_.reserve(n);
+        high_.reserve(n);
+        low_.reserve(n);
+        close_.reserve(n);
+        volume_.reserve(n);
+        timestamp_.reserve(n);
+        dte_.reserve(n);
+        minute_of_day_.reserve(n);
+        day_index_.reserve(n);
+        date_id_.reserve(n);
+        expiry_id_.reserve(n);
+        dt_id_.reserve(n);
+    }
+
+    void BarSeries::clear()
+    {
+        id_ = SeriesId();
+        open_.clear();
+        high_.clear();
+        low_.clear();
+        close_.clear();
+        volume_.clear();
+        timestamp_.clear();
+        dte_.clear();
+        minute_of_day_.clear();
+        day_index_.clear();
+        date_id_.clear();
+        expiry_id_.clear();
+        dt_id_.clear();
+        dates_.clear();
+        labels_.clear();
+        utc_offset_seconds_ = 0;
+        last_local_day_ = 0;
+    }
+
+    namespace
+    {
+        // Consecutive rows mostly repeat the previous label; skip the hash lookup then
+        uint16_t internRun(StringDictionary &dictionary, const Column<uint16_t> &ids,
+                           std::string_view value)
+        {
+            if (!ids.empty() && dictionary.lookup(ids.back()) == value)
+            {
+                return ids.back();
+            }
+            return static_cast<uint16_t>(dictionary.intern(value));
+        }
+    } // namespace
+
+    bool BarSeries::append(const Bar &bar)
+    {
+        if (!appendRowInfo(bar.timestamp, bar.date, bar.weekly_expiry_date, bar.dt, bar.dte))
+        {
+            return false;
+        }
+
+        open_.push_back(bar.open);
+        high_.push_back(bar.high);
+        low_.push_back(bar.low);
+        close_.push_back(bar.close);
+        volume_.push_back(bar.volume);
+        return true;
+    }
+
+    void BarSeries::adoptPrices(Column<double> open, Column<double> high, Column<double> low,
+                                Column<double> close, Column<double> volume)
+    {
+        open_ = std::move(open);
+        high_ = std::move(high);
+        low_ = std::move(low);
+        close_ = std::move(close);
+        volume_ = std::move(volume);
+    }
+
+    bool BarSeries::appendRowInfo(std::string_view timestamp, std::string_view date,
+                                  std::string_view weekly_expiry_date, std::string_view dt, int dte)
+    {
+        int64_t epoch_ns = 0;
+        int offset = 0;
+        if (!parseTimestamp(timestamp, epoch_ns, offset))
+        {
+            return false;
+        }
+
+        if (empty())
+        {
+            utc_offset_seconds_ = offset;
+        }
+
+        // Session fields are derived in the series' local time
+        int64_t local_seconds = epoch_ns / kNanosPerSecond + utc_offset_seconds_;
+        int64_t local_day = local_seconds / kSecondsPerDay;
+        int64_t seconds_of_day = local_seconds % kSecondsPerDay;
+        if (seconds_of_day < 0)
+        {
+            seconds_of_day += kSecondsPerDay;
+            --local_day;
+        }
+
+        uint32_t day_index = 0;
+        if (!empty())
+        {
+            day_index = day_index_.back() + (local_day != last_local_day_ ? 1 : 0);
+        }
+        last_local_day_ = local_day;
+
+        timestamp_.push_back(epoch_ns);
+        dte_.push_back(static_cast<int8_t>(dte));
+        minute_of_day_.push_back(static_cast<int16_t>(seconds_of_day / 60));
+        day_index_.push_back(day_index);
+        date_id_.push_back(internRun(dates_, date_id_, date));
+        expiry_id_.push_back(internRun(dates_, expiry_id_, weekly_expiry_date));
+        dt_id_.push_back(internRun(labels_, dt_id_, dt));
+        return true;
+    }
+
+    std::string BarSeries::timestampString(size_t index) const
+    {
+        return formatTimestamp(timestamp_[index], utc_offset_seconds_);
+    }
+
+    Bar BarSeries::at(size_t index) const
+    {
+        Bar bar;
+        bar.timestamp = timestampString(index);
+        bar.open = open_[index];
+        bar.high = high_[index];
+        bar.low = low_[index];
+        bar.close = close_[index];
+        bar.volume = volume_[index];
+        bar.date = date(index);
+        bar.weekly_expiry_date = weeklyExpiryDate(index);
+        bar.dt = dt(index);
+        bar.dte = dte_[index];
+        return bar;
+    }
+
+    size_t BarSeries::memoryUsage() const
+    {
+        size_t n = size();
+        return n * (5 * sizeof(double) + sizeof(int64_t) + sizeof(int8_t) + sizeof(int16_t) +
+                    sizeof(uint32_t) + 3 * sizeof(uint16_t));
+    }
+
+} // namespace backtest
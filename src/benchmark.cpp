@@ -0,0 +1,211 @@
+#include "benchmark.h"
+#include "backtest_engine.h"
+#include "portfolio.h"
+#include "indicators/simd_kernels.h"
+#include "indicators/ema_bank.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace backtest
+{
+
+    namespace
+    {
+        // Best-of-N wall time of one call, in seconds
+        template <typename Fn>
+        double bestSeconds(int iterations, Fn &&fn)
+        {
+            double best_seconds = 0.0;
+            for (int i = 0; i < iterations; ++i)
+            {
+                auto start = std::chrono::steady_clock::now();
+                fn();
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                if (i == 0 || seconds < best_seconds)
+                {
+                    best_seconds = seconds;
+                }
+            }
+            return best_seconds;
+        }
+
+        // Best-of-N wall time per call, reported as millions of bars per second
+        template <typename Fn>
+        void report(const std::string &label, size_t bars, int iterations, Fn &&fn)
+        {
+            double best_seconds = bestSeconds(iterations, fn);
+            double mbars_per_second = best_seconds > 0 ? bars / best_seconds / 1e6 : 0.0;
+            std::cout << "  " << std::left << std::setw(28) << label << std::right
+                      << std::fixed << std::setprecision(1) << std::setw(10) << mbars_per_second
+                      << " M bars/s" << std::endl;
+        }
+
+        // Best-of-N wall time per call, reported as nanoseconds per bar
+        template <typename Fn>
+        void reportPerBar(const std::string &label, size_t bars, int iterations, Fn &&fn)
+        {
+            double best_seconds = bestSeconds(iterations, fn);
+            std::cout << "  " << std::left << std::setw(40) << label << std::right
+                      << std::fixed << std::setprecision(2) << std::setw(10) << best_seconds * 1e9 / bars
+                      << " ns/bar" << std::endl;
+        }
+    } // namespace
+
+    void Benchmark::runKernelBenchmarks(const BarSeries &bars, int iterations)
+    {
+        size_t n = bars.size();
+        if (n == 0)
+        {
+            return;
+        }
+
+        const double *high = bars.high().data();
+        const double *low = bars.low().data();
+        const double *close = bars.close().data();
+
+        std::vector<double> true_range(n), middle(n), upper(n), lower(n);
+        std::vector<int8_t> events(n);
+
+        // Synthetic trend column for the flip kernel: close above/below midpoint
+        std::vector<int> trend(n);
+        indicators::simd::scalarKernels().midpoint(high, low, middle.data(), n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            trend[i] = close[i] >= middle[i] ? 1 : -1;
+        }
+
+        std::cout << "\n=== Indicator Kernel Benchmark (" << n << " bars, active: "
+                  << indicators::simd::activeKernels().name << ") ===" << std::endl;
+
+        for (const indicators::simd::Kernels *kernels : indicators::simd::availableKernels())
+        {
+            std::string name = kernels->name;
+            report(name + " true_range", n, iterations, [&]()
+                   { kernels->true_range(high, low, close, true_range.data(), n); });
+            report(name + " midpoint", n, iterations, [&]()
+                   { kernels->midpoint(high, low, middle.data(), n); });
+            report(name + " bands", n, iterations, [&]()
+                   { kernels->bands(middle.data(), true_range.data(), 2.0, upper.data(), lower.data(), n); });
+            report(name + " crossover", n, iterations, [&]()
+                   { kernels->crossover(close, middle.data(), events.data(), n); });
+            report(name + " trend_flip", n, iterations, [&]()
+                   { kernels->trend_flip(trend.data(), events.data(), n); });
+        }
+
+        // Default EMA crossover grid: one recurrence per period vs one banked pass.
+        // Both keep every series alive so allocation cost is comparable.
+        const std::vector<int> periods = {5, 10, 15, 20, 30, 40, 50};
+        std::string grid = "ema x" + std::to_string(periods.size());
+        report(grid + " per-period", n, iterations, [&]()
+               {
+                   std::vector<indicators::EMA> emas;
+                   emas.reserve(periods.size());
+                   for (int period : periods)
+                   {
+                       emas.emplace_back(period);
+                       emas.back().calculate(bars);
+                   } });
+        report(grid + " EMABank", n, iterations, [&]()
+               {
+                   indicators::EMABank bank(periods);
+                   bank.calculate(bars); });
+    }
+
+    void Benchmark::runExecutionBenchmarks(const BarSeries &bars, int iterations)
+    {
+        size_t n = bars.size();
+        if (n == 0)
+        {
+            return;
+        }
+
+        const double *close = bars.close().data();
+        const uint32_t *day_index = bars.dayIndex().data();
+
+        std::cout << "\n=== Execution Benchmark (" << n << " bars) ===" << std::endl;
+
+        // Position state machine alone: enter on an up-close, exit on a
+        // down-close or a new day, so it trades on a large share of bars
+        volatile double sink = 0.0; // keeps results observable
+        reportPerBar("portfolio open/close", n, iterations, [&]()
+                     {
+                         Portfolio portfolio(2000000.0);
+                         double pnl = 0.0;
+                         for (size_t i = 1; i < n; ++i)
+                         {
+                             bool up = close[i] > close[i - 1];
+                             if (portfolio.isFlat())
+                             {
+                                 if (up)
+                                 {
+                                     portfolio.open(Direction::LONG, close[i], i);
+                                 }
+                             }
+                             else if (!up || day_index[i] != day_index[i - 1])
+                             {
+                                 pnl += portfolio.close(close[i], i).pnl;
+                             }
+                         }
+                         sink = sink + pnl; });
+
+        // Whole backtest loop (indicators served from the engine's cache
+        // after the first iteration)
+        BacktestEngine engine;
+        const std::vector<StrategyParams> runs = {
+            {"EMA_Crossover", {5, 20}, -1},
+            {"Supertrend", {10, 3}, -1},
+            {"Supertrend", {10, 3}, 1}};
+        for (const auto &params : runs)
+        {
+            // Virtual calls per bar versus the loop compiled for the strategy
+            // type, each bar by bar; then the compiled loop event-driven
+            auto strategy = engine.createStrategy(params.strategy_name);
+            engine.setEventDriven(false);
+            reportPerBar(params.to_string() + " virtual", n, iterations, [&]()
+                         {
+                             TradeLogger logger;
+                             sink = sink + engine.runBacktest<strategy::StrategyBase>(bars, strategy.get(), params, logger).total_pnl; });
+            reportPerBar(params.to_string() + " inlined", n, iterations, [&]()
+                         {
+                             TradeLogger logger;
+                             sink = sink + engine.runBacktest(bars, strategy.get(), params, logger).total_pnl; });
+            engine.setEventDriven(true);
+            reportPerBar(params.to_string() + " event-driven", n, iterations, [&]()
+                         {
+                             TradeLogger logger;
+                             sink = sink + engine.runBacktest(bars, strategy.get(), params, logger).total_pnl; });
+        }
+
+        // DTE filters 1-5 of one parameter set as separate runs versus one
+        // shared pass over the signal column
+        const std::vector<int> dte_filters = {1, 2, 3, 4, 5};
+        StrategyParams sweep = {"Supertrend", {10, 3}, -1};
+        auto strategy = engine.createStrategy(sweep.strategy_name);
+        reportPerBar("Supertrend_10_3 DTE 1-5 separate", n, iterations, [&]()
+                     {
+                         for (int dte : dte_filters)
+                         {
+                             TradeLogger logger;
+                             StrategyParams params = sweep;
+                             params.dte_filter = dte;
+                             sink = sink + engine.runBacktest(bars, strategy.get(), params, logger).total_pnl;
+                         } });
+        reportPerBar("Supertrend_10_3 DTE 1-5 shared", n, iterations, [&]()
+                     {
+                         std::vector<std::unique_ptr<TradeLogger>> owned_loggers;
+                         std::vector<TradeLogger *> loggers;
+                         for (size_t k = 0; k < dte_filters.size(); ++k)
+                         {
+                             owned_loggers.push_back(std::make_unique<TradeLogger>());
+                             loggers.push_back(owned_loggers.back().get());
+                         }
+                         for (const PerformanceMetrics &metrics : engine.runBacktestDTEs(bars, sweep, dte_filters, loggers))
+                         {
+                             sink = sink + metrics.total_pnl;
+                         } });
+    }
+
+} // namespace backtest
@@ -0,0 +1,208 @@
+#include "csv_reader.h"
+#include <charconv>
+#include <cstring>
+#include <iostream>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace backtest
+{
+
+    namespace
+    {
+        constexpr size_t kBlockSize = 64;
+    }
+
+    CSVReader::CSVReader(char delimiter)
+        : delimiter_(delimiter), data_(nullptr), size_(0),
+          cursor_(0), block_(0), mask_(0), line_number_(0), next_line_(1) {}
+
+    CSVReader::~CSVReader()
+    {
+        close();
+    }
+
+    bool CSVReader::open(const std::string &path)
+    {
+        close();
+
+        if (!file_.open(path))
+        {
+            std::cerr << "Error: Cannot open CSV file: " << path << std::endl;
+            return false;
+        }
+
+        // One sequential pass: let the kernel read ahead aggressively
+        file_.adviseSequential();
+        data_ = file_.data();
+        size_ = file_.size();
+        mask_ = size_ > 0 ? separatorMask(0) : 0;
+        return true;
+    }
+
+    void CSVReader::open(const char *data, size_t size)
+    {
+        close();
+        data_ = data;
+        size_ = size;
+        mask_ = size_ > 0 ? separatorMask(0) : 0;
+    }
+
+    size_t CSVReader::lineStart(size_t offset) const
+    {
+        if (offset == 0 || offset >= size_)
+        {
+            return offset >= size_ ? size_ : 0;
+        }
+        const void *newline = std::memchr(data_ + offset - 1, '\n', size_ - offset + 1);
+        return newline ? static_cast<const char *>(newline) - data_ + 1 : size_;
+    }
+
+    void CSVReader::release(size_t offset)
+    {
+        if (file_.isOpen())
+        {
+            file_.release(offset);
+        }
+    }
+
+    void CSVReader::close()
+    {
+        file_.close();
+        data_ = nullptr;
+        size_ = 0;
+        cursor_ = 0;
+        block_ = 0;
+        mask_ = 0;
+        line_number_ = 0;
+        next_line_ = 1;
+    }
+
+    uint64_t CSVReader::separatorMask(size_t block) const
+    {
+        const char *p = data_ + block;
+        uint64_t mask = 0;
+
+#if defined(__SSE2__)
+        if (block + kBlockSize <= size_)
+        {
+            const __m128i newline = _mm_set1_epi8('\n');
+            const __m128i delimiter = _mm_set1_epi8(delimiter_);
+            for (size_t k = 0; k < kBlockSize; k += 16)
+            {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + k));
+                __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, newline), _mm_cmpeq_epi8(chunk, delimiter));
+                mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(hits))) << k;
+            }
+            return mask;
+        }
+#endif
+
+        size_t n = size_ - block < kBlockSize ? size_ - block : kBlockSize;
+        for (size_t k = 0; k < n; ++k)
+        {
+            if (p[k] == '\n' || p[k] == delimiter_)
+            {
+                mask |= uint64_t(1) << k;
+            }
+        }
+        return mask;
+    }
+
+    size_t CSVReader::nextSeparator()
+    {
+        while (mask_ == 0)
+        {
+            block_ += kBlockSize;
+            if (block_ >= size_)
+            {
+                block_ = size_;
+                return size_;
+            }
+            mask_ = separatorMask(block_);
+        }
+
+        size_t offset = block_ + static_cast<size_t>(__builtin_ctzll(mask_));
+        mask_ &= mask_ - 1;
+        return offset;
+    }
+
+    bool CSVReader::nextRow(std::vector<std::string_view> &fields)
+    {
+        while (cursor_ < size_)
+        {
+            fields.clear();
+            line_number_ = next_line_;
+            size_t start = cursor_;
+            bool has_content = false;
+
+            while (true)
+            {
+                size_t separator = nextSeparator();
+                size_t end = separator;
+                bool end_of_line = separator == size_ || data_[separator] == '\n';
+                if (end_of_line && end > start && data_[end - 1] == '\r')
+                {
+                    --end;
+                }
+
+                fields.emplace_back(data_ + start, end - start);
+                has_content = has_content || end > start || !end_of_line;
+                start = separator + 1;
+
+                if (end_of_line)
+                {
+                    break;
+                }
+            }
+
+            cursor_ = start;
+            ++next_line_;
+            if (has_content)
+            {
+                return true;
+            }
+        }
+
+        fields.clear();
+        return false;
+    }
+
+    std::string_view CSVReader::trim(std::string_view field)
+    {
+        size_t first = field.find_first_not_of(" \t\r\n");
+        if (first == std::string_view::npos)
+        {
+            return std::string_view();
+        }
+        size_t last = field.find_last_not_of(" \t\r\n");
+        return field.substr(first, last - first + 1);
+    }
+
+    bool CSVReader::parseDouble(std::string_view field, double &value)
+    {
+        field = trim(field);
+        if (!field.empty() && field.front() == '+')
+        {
+            field.remove_prefix(1);
+        }
+        const char *end = field.data() + field.size();
+        auto result = std::from_chars(field.data(), end, value);
+        return result.ec == std::errc() && result.ptr == end && !field.empty();
+    }
+
+    bool CSVReader::parseInt(std::string_view field, long &value)
+    {
+        field = trim(field);
+        if (!field.empty() && field.front() == '+')
+        {
+            field.remove_prefix(1);
+        }
+        const char *end = field.data() + field.size();
+        auto result = std::from_chars(field.data(), end, value);
+        return result.ec == std::errc() && result.ptr == end && !field.empty();
+    }
+
+} // namespace backtest
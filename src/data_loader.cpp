@@ -1,13 +1,25 @@
 #include "data_loader.h"
-#include <fstream>
-#include <sstream>
+#include "bar_cache.h"
+#include "csv_reader.h"
+#include "thread_pool.h"
+#include "time_utils.h"
 #include <iostream>
 #include <arrow/api.h>
 #include <arrow/io/api.h>
 #include <parquet/arrow/reader.h>
 #include <parquet/arrow/writer.h>
+#include <parquet/file_reader.h>
+#include <parquet/metadata.h>
+#include <parquet/properties.h>
+#include <parquet/statistics.h>
 #include <algorithm>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <future>
 #include <iomanip>
+#include <string_view>
+#include <utility>
 
 namespace backtest
 {
@@ -15,132 +27,147 @@ namespace backtest
     int DataLoader::calculateDTE(const std::string &current_date,
                                  const std::string &expiry_date)
     {
-        // Simple DTE calculation based on date difference
-        // Format: DD-MM-YYYY
-        auto parseDate = [](const std::string &date) -> std::tm
-        {
-            std::tm tm = {};
-            std::istringstream ss(date);
-            ss >> std::get_time(&tm, "%d-%m-%Y");
-            return tm;
-        };
-
-        std::tm current = parseDate(current_date);
-        std::tm expiry = parseDate(expiry_date);
-
-        std::time_t current_time = std::mktime(&current);
-        std::time_t expiry_time = std::mktime(&expiry);
-
-        double diff_seconds = std::difftime(expiry_time, current_time);
-        int days = static_cast<int>(diff_seconds / (60 * 60 * 24));
-
-        return std::max(1, std::min(5, days + 1)); // Clamp to 1-5
+        return TradingCalendar(TradingCalendar::DTEMode::CalendarDays).dte(current_date, expiry_date);
     }
 
-    std::vector<Bar> DataLoader::loadFromCSV(const std::string &csv_path)
+    namespace
     {
-        std::vector<Bar> bars;
-        std::ifstream file(csv_path);
+        // CSV bytes handed to one conversion job; the pipeline keeps at most
+        // (threads + 1) chunks in memory regardless of file size
+        constexpr size_t kConvertChunkBytes = 32 * 1024 * 1024;
+
+        constexpr const char *kConversionTagKey = "backtest.conversion";
 
-        if (!file.is_open())
+        std::shared_ptr<arrow::Schema> barSchema()
         {
-            std::cerr << "Error: Cannot open CSV file: " << csv_path << std::endl;
-            return bars;
+            return arrow::schema({arrow::field("timestamp", arrow::utf8()),
+                                  arrow::field("open", arrow::float64()),
+                                  arrow::field("high", arrow::float64()),
+                                  arrow::field("low", arrow::float64()),
+                                  arrow::field("close", arrow::float64()),
+                                  arrow::field("date", arrow::utf8()),
+                                  arrow::field("weekly_expiry_date", arrow::utf8()),
+                                  arrow::field("dt", arrow::utf8()),
+                                  arrow::field("dte", arrow::int32())});
         }
 
-        std::string line;
-        std::getline(file, line); // Skip header
-
-        while (std::getline(file, line))
+        // One chunk of CSV rows as Arrow columns, in time order
+        struct ConvertedChunk
         {
-            std::istringstream ss(line);
-            Bar bar;
-            std::string field;
-
-            std::getline(ss, bar.timestamp, '\t');
-            std::getline(ss, field, '\t');
-            bar.open = std::stod(field);
-            std::getline(ss, field, '\t');
-            bar.high = std::stod(field);
-            std::getline(ss, field, '\t');
-            bar.low = std::stod(field);
-            std::getline(ss, field, '\t');
-            bar.close = std::stod(field);
-            std::getline(ss, bar.date, '\t');
-            std::getline(ss, bar.weekly_expiry_date, '\t');
-            std::getline(ss, bar.dt, '\t');
-
-            // Calculate DTE
-            bar.dte = calculateDTE(bar.date, bar.weekly_expiry_date);
+            std::shared_ptr<arrow::Table> table;
+            std::vector<int32_t> dte; // per row, for row-group cuts
+            int64_t first_timestamp = 0;
+            int64_t last_timestamp = 0;
+            size_t skipped = 0;
+        };
 
-            bars.push_back(bar);
+        ConvertedChunk convertChunk(const char *data, size_t size, char delimiter,
+                                    TradingCalendar &calendar,
+                                    const std::shared_ptr<arrow::Schema> &schema)
+        {
+            struct Row
+            {
+                int64_t epoch_ns;
+                int utc_offset;
+                double open, high, low, close;
+                std::string_view date, expiry, dt;
+                int32_t dte;
+            };
+
+            ConvertedChunk chunk;
+            CSVReader reader(delimiter);
+            reader.open(data, size);
+
+            std::vector<Row> rows;
+            std::vector<std::string_view> fields;
+            while (reader.nextRow(fields))
+            {
+                Row row;
+                if (fields.size() < 8 ||
+                    !parseTimestamp(CSVReader::trim(fields[0]), row.epoch_ns, row.utc_offset) ||
+                    !CSVReader::parseDouble(fields[1], row.open) ||
+                    !CSVReader::parseDouble(fields[2], row.high) ||
+                    !CSVReader::parseDouble(fields[3], row.low) ||
+                    !CSVReader::parseDouble(fields[4], row.close))
+                {
+                    ++chunk.skipped;
+                    continue;
+                }
+
+                row.date = fields[5];
+                row.expiry = fields[6];
+                row.dt = fields[7];
+                row.dte = calendar.dte(row.date, row.expiry);
+                rows.push_back(row);
+            }
+
+            std::stable_sort(rows.begin(), rows.end(), [](const Row &a, const Row &b)
+                             { return a.epoch_ns < b.epoch_ns; });
+
+            arrow::StringBuilder timestamp_builder, date_builder, expiry_builder, dt_builder;
+            arrow::DoubleBuilder open_builder, high_builder, low_builder, close_builder;
+            arrow::Int32Builder dte_builder;
+            for (arrow::ArrayBuilder *builder : std::initializer_list<arrow::ArrayBuilder *>{
+                     &timestamp_builder, &date_builder, &expiry_builder, &dt_builder, &open_builder,
+                     &high_builder, &low_builder, &close_builder, &dte_builder})
+            {
+                PARQUET_THROW_NOT_OK(builder->Reserve(static_cast<int64_t>(rows.size())));
+            }
+
+            chunk.dte.reserve(rows.size());
+            for (const Row &row : rows)
+            {
+                timestamp_builder.Append(formatTimestamp(row.epoch_ns, row.utc_offset));
+                open_builder.UnsafeAppend(row.open);
+                high_builder.UnsafeAppend(row.high);
+                low_builder.UnsafeAppend(row.low);
+                close_builder.UnsafeAppend(row.close);
+                date_builder.Append(row.date.data(), static_cast<int32_t>(row.date.size()));
+                expiry_builder.Append(row.expiry.data(), static_cast<int32_t>(row.expiry.size()));
+                dt_builder.Append(row.dt.data(), static_cast<int32_t>(row.dt.size()));
+                dte_builder.UnsafeAppend(row.dte);
+                chunk.dte.push_back(row.dte);
+            }
+
+            std::shared_ptr<arrow::Array> timestamp_array, open_array, high_array, low_array, close_array,
+                date_array, expiry_array, dt_array, dte_array;
+            PARQUET_THROW_NOT_OK(timestamp_builder.Finish(&timestamp_array));
+            PARQUET_THROW_NOT_OK(open_builder.Finish(&open_array));
+            PARQUET_THROW_NOT_OK(high_builder.Finish(&high_array));
+            PARQUET_THROW_NOT_OK(low_builder.Finish(&low_array));
+            PARQUET_THROW_NOT_OK(close_builder.Finish(&close_array));
+            PARQUET_THROW_NOT_OK(date_builder.Finish(&date_array));
+            PARQUET_THROW_NOT_OK(expiry_builder.Finish(&expiry_array));
+            PARQUET_THROW_NOT_OK(dt_builder.Finish(&dt_array));
+            PARQUET_THROW_NOT_OK(dte_builder.Finish(&dte_array));
+
+            chunk.table = arrow::Table::Make(schema, {timestamp_array, open_array, high_array, low_array, close_array,
+                                                      date_array, expiry_array, dt_array, dte_array});
+            if (!rows.empty())
+            {
+                chunk.first_timestamp = rows.front().epoch_ns;
+                chunk.last_timestamp = rows.back().epoch_ns;
+            }
+            return chunk;
         }
-
-        file.close();
-        std::cout << "Loaded " << bars.size() << " bars from CSV" << std::endl;
-        return bars;
-    }
+    } // namespace
 
     bool DataLoader::convertCSVToParquet(const std::string &csv_path,
-                                         const std::string &parquet_path)
+                                         const std::string &parquet_path,
+                                         const ConvertOptions &options)
     {
         std::cout << "Converting CSV to Parquet..." << std::endl;
+        auto start_time = std::chrono::steady_clock::now();
 
-        // Load CSV data
-        std::vector<Bar> bars = loadFromCSV(csv_path);
-        if (bars.empty())
+        CSVReader source(options.delimiter);
+        if (!source.open(csv_path))
         {
             return false;
         }
 
-        // Create Arrow schema
-        auto schema = arrow::schema({arrow::field("timestamp", arrow::utf8()),
-                                     arrow::field("open", arrow::float64()),
-                                     arrow::field("high", arrow::float64()),
-                                     arrow::field("low", arrow::float64()),
-                                     arrow::field("close", arrow::float64()),
-                                     arrow::field("date", arrow::utf8()),
-                                     arrow::field("weekly_expiry_date", arrow::utf8()),
-                                     arrow::field("dt", arrow::utf8()),
-                                     arrow::field("dte", arrow::int32())});
-
-        // Create builders
-        arrow::StringBuilder timestamp_builder;
-        arrow::DoubleBuilder open_builder, high_builder, low_builder, close_builder;
-        arrow::StringBuilder date_builder, expiry_builder, dt_builder;
-        arrow::Int32Builder dte_builder;
-
-        // Append data
-        for (const auto &bar : bars)
-        {
-            timestamp_builder.Append(bar.timestamp);
-            open_builder.Append(bar.open);
-            high_builder.Append(bar.high);
-            low_builder.Append(bar.low);
-            close_builder.Append(bar.close);
-            date_builder.Append(bar.date);
-            expiry_builder.Append(bar.weekly_expiry_date);
-            dt_builder.Append(bar.dt);
-            dte_builder.Append(bar.dte);
-        }
-
-        // Finish arrays
-        std::shared_ptr<arrow::Array> timestamp_array, open_array, high_array,
-            low_array, close_array, date_array,
-            expiry_array, dt_array, dte_array;
-        timestamp_builder.Finish(&timestamp_array);
-        open_builder.Finish(&open_array);
-        high_builder.Finish(&high_array);
-        low_builder.Finish(&low_array);
-        close_builder.Finish(&close_array);
-        date_builder.Finish(&date_array);
-        expiry_builder.Finish(&expiry_array);
-        dt_builder.Finish(&dt_array);
-        dte_builder.Finish(&dte_array);
-
-        // Create table
-        auto table = arrow::Table::Make(schema, {timestamp_array, open_array, high_array, low_array, close_array,
-                                                 date_array, expiry_array, dt_array, dte_array});
+        // The tag lets later runs tell whether the file matches their options
+        auto schema = barSchema()->WithMetadata(
+            arrow::key_value_metadata({kConversionTagKey}, {conversionTag(options)}));
 
         // Write to Parquet
         std::shared_ptr<arrow::io::FileOutputStream> outfile;
@@ -148,59 +175,541 @@ namespace backtest
             outfile,
             arrow::io::FileOutputStream::Open(parquet_path));
 
-        PARQUET_THROW_NOT_OK(
-            parquet::arrow::WriteTable(*table, arrow::default_memory_pool(),
-                                       outfile, 100000));
+        parquet::WriterProperties::Builder properties;
+        properties.enable_statistics();
+        properties.max_row_group_length(static_cast<int64_t>(options.max_row_group_rows));
+
+        std::unique_ptr<parquet::arrow::FileWriter> writer;
+        PARQUET_ASSIGN_OR_THROW(
+            writer,
+            parquet::arrow::FileWriter::Open(*schema, arrow::default_memory_pool(),
+                                             outfile, properties.build()));
+
+        // Chunks split at line boundaries are parsed on the pool while this
+        // thread writes finished chunks in file order
+        struct PendingChunk
+        {
+            size_t end_offset;
+            std::future<ConvertedChunk> result;
+        };
+
+        size_t file_size = source.fileSize();
+        size_t next_offset = source.lineStart(1); // skip header
+        std::deque<PendingChunk> pending;
+        WorkStealingPool pool(options.num_threads);
+
+        auto submitNext = [&]()
+        {
+            size_t begin = next_offset;
+            size_t end = source.lineStart(std::min(begin + kConvertChunkBytes, file_size));
+            next_offset = end;
+
+            auto promise = std::make_shared<std::promise<ConvertedChunk>>();
+            pending.push_back({end, promise->get_future()});
+            const char *data = source.data() + begin;
+            pool.submit([promise, data, size = end - begin, delimiter = options.delimiter,
+                         calendar = options.calendar, schema]() mutable
+                        {
+                            try
+                            {
+                                promise->set_value(convertChunk(data, size, delimiter, calendar, schema));
+                            }
+                            catch (...)
+                            {
+                                promise->set_exception(std::current_exception());
+                            } });
+        };
+
+        while (pending.size() < pool.size() + 1 && next_offset < file_size)
+        {
+            submitNext();
+        }
+
+        int64_t num_rows = 0;
+        int64_t num_row_groups = 0;
+
+        // Rows of the row group being filled; it may span several chunks
+        std::vector<std::shared_ptr<arrow::Table>> open_group;
+        int64_t open_rows = 0;
+        int32_t last_dte = 0;
+        auto writeOpenGroup = [&]()
+        {
+            if (open_rows == 0)
+            {
+                return;
+            }
+            std::shared_ptr<arrow::Table> group;
+            PARQUET_ASSIGN_OR_THROW(group, arrow::ConcatenateTables(open_group));
+            PARQUET_THROW_NOT_OK(writer->WriteTable(*group, open_rows));
+            open_group.clear();
+            open_rows = 0;
+            ++num_row_groups;
+        };
+
+        size_t skipped = 0;
+        int64_t last_timestamp = 0;
+        bool out_of_order = false;
+        while (!pending.empty())
+        {
+            ConvertedChunk chunk = pending.front().result.get();
+            size_t consumed = pending.front().end_offset;
+            pending.pop_front();
+            if (next_offset < file_size)
+            {
+                submitNext();
+            }
+
+            skipped += chunk.skipped;
+            const int64_t rows = chunk.table->num_rows();
+            if (rows > 0)
+            {
+                out_of_order = out_of_order || (num_rows > 0 && chunk.first_timestamp < last_timestamp);
+                last_timestamp = chunk.last_timestamp;
+            }
+
+            // Cut at the first DTE change past the minimum size, so groups
+            // hold whole days (calendar-day DTE changes daily) without
+            // shrinking to one day each
+            int64_t group_start = 0;
+            for (int64_t k = 0; k < rows; ++k)
+            {
+                int64_t group_rows = open_rows + (k - group_start);
+                bool full = group_rows >= static_cast<int64_t>(options.max_row_group_rows);
+                bool dte_cut = group_rows >= static_cast<int64_t>(options.min_row_group_rows) &&
+                               group_rows > 0 && chunk.dte[k] != last_dte;
+                if (full || dte_cut)
+                {
+                    if (k > group_start)
+                    {
+                        open_group.push_back(chunk.table->Slice(group_start, k - group_start));
+                        open_rows += k - group_start;
+                    }
+                    writeOpenGroup();
+                    group_start = k;
+                }
+                last_dte = chunk.dte[k];
+            }
+            if (rows > group_start)
+            {
+                open_group.push_back(chunk.table->Slice(group_start, rows - group_start));
+                open_rows += rows - group_start;
+            }
+            num_rows += rows;
+
+            // Parsed bytes are not needed again
+            source.release(consumed);
+        }
+        pool.wait();
+        writeOpenGroup();
+        PARQUET_THROW_NOT_OK(writer->Close());
+
+        if (skipped > 0)
+        {
+            std::cerr << "Warning: Skipped " << skipped << " malformed rows" << std::endl;
+        }
+        if (out_of_order)
+        {
+            std::cerr << "Warning: CSV is not in time order across chunks; "
+                      << "row groups overlap and date pruning is less effective" << std::endl;
+        }
+        if (num_rows == 0)
+        {
+            std::cerr << "Error: No rows converted from " << csv_path << std::endl;
+            return false;
+        }
 
-        std::cout << "Successfully converted to Parquet: " << parquet_path << std::endl;
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+        double megabytes = file_size / (1024.0 * 1024.0);
+        std::cout << "Successfully converted to Parquet: " << parquet_path
+                  << " (" << num_rows << " rows, " << num_row_groups << " row groups, "
+                  << std::fixed << std::setprecision(1) << (seconds > 0.0 ? megabytes / seconds : 0.0)
+                  << " MB/s on " << pool.size() << " threads)" << std::defaultfloat << std::endl;
         return true;
     }
 
-    std::vector<Bar> DataLoader::loadFromParquet(const std::string &parquet_path)
+    namespace
     {
-        std::vector<Bar> bars;
+        // Walks a chunked Arrow column row by row across chunk (row group) boundaries
+        template <typename ArrayType>
+        class ChunkCursor
+        {
+        public:
+            explicit ChunkCursor(const std::shared_ptr<arrow::ChunkedArray> &column)
+                : column_(column), chunk_(-1), row_(0), length_(0), array_(nullptr) {}
+
+            auto next()
+            {
+                while (row_ >= length_)
+                {
+                    array_ = static_cast<const ArrayType *>(column_->chunk(++chunk_).get());
+                    length_ = array_->length();
+                    row_ = 0;
+                }
+                return array_->GetView(row_++);
+            }
+
+        private:
+            std::shared_ptr<arrow::ChunkedArray> column_;
+            int chunk_;
+            int64_t row_;
+            int64_t length_;
+            const ArrayType *array_;
+        };
+
+        template <typename View>
+        std::string_view toStringView(const View &view)
+        {
+            return std::string_view(view.data(), view.size());
+        }
 
-        std::shared_ptr<arrow::io::ReadableFile> infile;
+        // A single-chunk column is exposed as-is; row groups are stitched
+        // together with one bulk copy per chunk
+        Column<double> priceColumn(const std::shared_ptr<arrow::ChunkedArray> &column)
+        {
+            if (column->num_chunks() == 1)
+            {
+                auto array = std::static_pointer_cast<arrow::DoubleArray>(column->chunk(0));
+                return Column<double>::view(array->raw_values(), array->length(), column);
+            }
+
+            AlignedVector<double> values(column->length());
+            double *out = values.data();
+            for (const auto &chunk : column->chunks())
+            {
+                auto array = std::static_pointer_cast<arrow::DoubleArray>(chunk);
+                out = std::copy(array->raw_values(), array->raw_values() + array->length(), out);
+            }
+            return Column<double>::adopt(std::move(values));
+        }
+
+        // Timestamps are "YYYY-MM-DD HH:MM..."; with a fixed UTC offset they sort as strings
+        bool inDateRange(std::string_view timestamp, const DataLoader::LoadFilter &filter)
+        {
+            std::string_view date = timestamp.substr(0, 10);
+            return (filter.from_date.empty() || date >= filter.from_date) &&
+                   (filter.to_date.empty() || date <= filter.to_date);
+        }
+
+        int minuteOfDay(std::string_view timestamp)
+        {
+            if (timestamp.size() < 16 || timestamp[13] != ':')
+            {
+                return -1;
+            }
+            auto digit = [&](size_t i)
+            { return timestamp[i] - '0'; };
+            return (digit(11) * 10 + digit(12)) * 60 + digit(14) * 10 + digit(15);
+        }
+
+        std::string_view byteArrayView(const parquet::ByteArray &value)
+        {
+            return std::string_view(reinterpret_cast<const char *>(value.ptr), value.len);
+        }
+
+        // Whether the group's timestamps cover more than one date
+        bool rowGroupSpansDays(const parquet::RowGroupMetaData &row_group, int timestamp_column)
+        {
+            auto timestamp_chunk = row_group.ColumnChunk(timestamp_column);
+            auto timestamp_stats = std::dynamic_pointer_cast<parquet::ByteArrayStatistics>(
+                timestamp_chunk->statistics());
+            if (!timestamp_chunk->is_stats_set() || !timestamp_stats || !timestamp_stats->HasMinMax())
+            {
+                return true;
+            }
+            return byteArrayView(timestamp_stats->min()).substr(0, 10) !=
+                   byteArrayView(timestamp_stats->max()).substr(0, 10);
+        }
+
+        // False only when column statistics prove no row of the group can match
+        bool rowGroupMayMatch(const parquet::RowGroupMetaData &row_group, int timestamp_column,
+                              int dte_column, const DataLoader::LoadFilter &filter)
+        {
+            auto timestamp_chunk = row_group.ColumnChunk(timestamp_column);
+            auto timestamp_stats = std::dynamic_pointer_cast<parquet::ByteArrayStatistics>(
+                timestamp_chunk->statistics());
+            if (timestamp_chunk->is_stats_set() && timestamp_stats && timestamp_stats->HasMinMax())
+            {
+                std::string_view first = byteArrayView(timestamp_stats->min());
+                std::string_view last = byteArrayView(timestamp_stats->max());
+                if (!filter.from_date.empty() && last.substr(0, 10) < filter.from_date)
+                {
+                    return false;
+                }
+                if (!filter.to_date.empty() && first.substr(0, 10) > filter.to_date)
+                {
+                    return false;
+                }
+
+                // A single-day group lying wholly before or after the session window
+                if (filter.session && first.substr(0, 10) == last.substr(0, 10))
+                {
+                    int first_minute = minuteOfDay(first);
+                    int last_minute = minuteOfDay(last);
+                    if (first_minute >= 0 && last_minute >= 0 &&
+                        (last_minute < filter.session->open_minute ||
+                         first_minute > filter.session->close_minute))
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            if (!filter.dte.empty())
+            {
+                auto dte_chunk = row_group.ColumnChunk(dte_column);
+                auto dte_stats = std::dynamic_pointer_cast<parquet::Int32Statistics>(dte_chunk->statistics());
+                if (dte_chunk->is_stats_set() && dte_stats && dte_stats->HasMinMax())
+                {
+                    for (int dte : filter.dte)
+                    {
+                        if (dte >= dte_stats->min() && dte <= dte_stats->max())
+                        {
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Row-wise load; skips rows whose timestamp cannot be parsed or that
+        // fall outside the filter's date range
+        BarSeries loadRows(const arrow::Table &table, const DataLoader::LoadFilter &filter)
+        {
+            BarSeries bars;
+            bars.reserve(table.num_rows());
+
+            ChunkCursor<arrow::StringArray> timestamp(table.GetColumnByName("timestamp"));
+            ChunkCursor<arrow::DoubleArray> open(table.GetColumnByName("open"));
+            ChunkCursor<arrow::DoubleArray> high(table.GetColumnByName("high"));
+            ChunkCursor<arrow::DoubleArray> low(table.GetColumnByName("low"));
+            ChunkCursor<arrow::DoubleArray> close(table.GetColumnByName("close"));
+            ChunkCursor<arrow::StringArray> date(table.GetColumnByName("date"));
+            ChunkCursor<arrow::StringArray> expiry(table.GetColumnByName("weekly_expiry_date"));
+            ChunkCursor<arrow::StringArray> dt(table.GetColumnByName("dt"));
+            ChunkCursor<arrow::Int32Array> dte(table.GetColumnByName("dte"));
+
+            Bar bar;
+            for (int64_t i = 0; i < table.num_rows(); ++i)
+            {
+                bar.timestamp = std::string(toStringView(timestamp.next()));
+                bar.open = open.next();
+                bar.high = high.next();
+                bar.low = low.next();
+                bar.close = close.next();
+                bar.date = std::string(toStringView(date.next()));
+                bar.weekly_expiry_date = std::string(toStringView(expiry.next()));
+                bar.dt = std::string(toStringView(dt.next()));
+                bar.dte = dte.next();
+
+                if (!inDateRange(bar.timestamp, filter))
+                {
+                    continue;
+                }
+
+                if (!bars.append(bar))
+                {
+                    std::cerr << "Warning: Skipping row with invalid timestamp: " << bar.timestamp << std::endl;
+                }
+            }
+            return bars;
+        }
+    } // namespace
+
+    std::string DataLoader::conversionTag(const ConvertOptions &options)
+    {
+        std::string tag = "dte=" + options.calendar.fingerprint();
+        if (options.min_row_group_rows == 0)
+        {
+            tag += ";row_groups=day";
+        }
+        return tag;
+    }
+
+    std::string DataLoader::readConversionTag(const std::string &parquet_path)
+    {
+        try
+        {
+            std::unique_ptr<parquet::ParquetFileReader> reader = parquet::ParquetFileReader::OpenFile(parquet_path);
+            std::shared_ptr<const arrow::KeyValueMetadata> metadata = reader->metadata()->key_value_metadata();
+            int index = metadata ? metadata->FindKey(kConversionTagKey) : -1;
+            return index >= 0 ? metadata->value(index) : conversionTag(ConvertOptions());
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Error: Cannot read " << parquet_path << ": " << e.what() << std::endl;
+            return "";
+        }
+    }
+
+    BarSeries DataLoader::loadCached(const std::string &parquet_path,
+                                     const std::string &cache_path,
+                                     const std::vector<std::string> &source_paths)
+    {
+        std::vector<std::string> sources = source_paths;
+        sources.push_back(parquet_path);
+        uint64_t fingerprint = BarCache::fingerprint(sources);
+
+        auto start = std::chrono::steady_clock::now();
+        BarSeries bars;
+        if (BarCache::load(cache_path, fingerprint, bars))
+        {
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "Mapped " << bars.size() << " bars from cache " << cache_path
+                      << " in " << seconds * 1000.0 << " ms" << std::endl;
+            return bars;
+        }
+
+        bars = loadFromParquet(parquet_path);
+        if (!bars.empty() && BarCache::save(bars, cache_path, fingerprint))
+        {
+            std::cout << "Wrote bar cache " << cache_path << std::endl;
+        }
+        return bars;
+    }
+
+    BarSeries DataLoader::loadFromParquet(const std::string &parquet_path, const LoadFilter &filter)
+    {
+        BarSeries bars;
+
+        // Memory-map the file so pages are decoded straight from the page cache
+        std::shared_ptr<arrow::io::MemoryMappedFile> infile;
         PARQUET_ASSIGN_OR_THROW(
             infile,
-            arrow::io::ReadableFile::Open(parquet_path));
+            arrow::io::MemoryMappedFile::Open(parquet_path, arrow::io::FileMode::READ));
 
         std::unique_ptr<parquet::arrow::FileReader> reader;
         PARQUET_THROW_NOT_OK(
             parquet::arrow::OpenFile(infile, arrow::default_memory_pool(), &reader));
+        reader->set_use_threads(true);
+
+        // Project only the columns BarSeries keeps
+        std::shared_ptr<arrow::Schema> schema;
+        PARQUET_THROW_NOT_OK(reader->GetSchema(&schema));
+
+        const std::vector<std::pair<std::string, arrow::Type::type>> columns = {
+            {"timestamp", arrow::Type::STRING},
+            {"open", arrow::Type::DOUBLE},
+            {"high", arrow::Type::DOUBLE},
+            {"low", arrow::Type::DOUBLE},
+            {"close", arrow::Type::DOUBLE},
+            {"date", arrow::Type::STRING},
+            {"weekly_expiry_date", arrow::Type::STRING},
+            {"dt", arrow::Type::STRING},
+            {"dte", arrow::Type::INT32}};
+
+        std::vector<int> indices;
+        for (const auto &column : columns)
+        {
+            int index = schema->GetFieldIndex(column.first);
+            if (index < 0 || schema->field(index)->type()->id() != column.second)
+            {
+                std::cerr << "Error: Parquet file has no usable column '" << column.first
+                          << "': " << parquet_path << std::endl;
+                return bars;
+            }
+            indices.push_back(index);
+        }
+
+        int volume_index = schema->GetFieldIndex("volume");
+        bool has_volume = volume_index >= 0 && schema->field(volume_index)->type()->id() == arrow::Type::DOUBLE;
+        if (has_volume)
+        {
+            indices.push_back(volume_index);
+        }
 
         std::shared_ptr<arrow::Table> table;
-        PARQUET_THROW_NOT_OK(reader->ReadTable(&table));
-
-        // Extract columns
-        auto timestamp_col = std::static_pointer_cast<arrow::StringArray>(table->column(0)->chunk(0));
-        auto open_col = std::static_pointer_cast<arrow::DoubleArray>(table->column(1)->chunk(0));
-        auto high_col = std::static_pointer_cast<arrow::DoubleArray>(table->column(2)->chunk(0));
-        auto low_col = std::static_pointer_cast<arrow::DoubleArray>(table->column(3)->chunk(0));
-        auto close_col = std::static_pointer_cast<arrow::DoubleArray>(table->column(4)->chunk(0));
-        auto date_col = std::static_pointer_cast<arrow::StringArray>(table->column(5)->chunk(0));
-        auto expiry_col = std::static_pointer_cast<arrow::StringArray>(table->column(6)->chunk(0));
-        auto dt_col = std::static_pointer_cast<arrow::StringArray>(table->column(7)->chunk(0));
-        auto dte_col = std::static_pointer_cast<arrow::Int32Array>(table->column(8)->chunk(0));
-
-        // Fill bars
-        bars.reserve(table->num_rows());
-        for (int64_t i = 0; i < table->num_rows(); ++i)
+        if (filter.empty())
         {
-            Bar bar;
-            bar.timestamp = timestamp_col->GetString(i);
-            bar.open = open_col->Value(i);
-            bar.high = high_col->Value(i);
-            bar.low = low_col->Value(i);
-            bar.close = close_col->Value(i);
-            bar.date = date_col->GetString(i);
-            bar.weekly_expiry_date = expiry_col->GetString(i);
-            bar.dt = dt_col->GetString(i);
-            bar.dte = dte_col->Value(i);
-            bars.push_back(bar);
-        }
-
-        std::cout << "Loaded " << bars.size() << " bars from Parquet" << std::endl;
+            PARQUET_THROW_NOT_OK(reader->ReadTable(indices, &table));
+        }
+        else
+        {
+            // Skip row groups whose statistics rule them out
+            auto metadata = reader->parquet_reader()->metadata();
+            int timestamp_column = metadata->schema()->ColumnIndex("timestamp");
+            int dte_column = metadata->schema()->ColumnIndex("dte");
+
+            std::vector<int> row_groups;
+            int multi_day = 0;
+            for (int rg = 0; rg < metadata->num_row_groups(); ++rg)
+            {
+                std::unique_ptr<parquet::RowGroupMetaData> row_group = metadata->RowGroup(rg);
+                multi_day += rowGroupSpansDays(*row_group, timestamp_column) ? 1 : 0;
+                if (rowGroupMayMatch(*row_group, timestamp_column, dte_column, filter))
+                {
+                    row_groups.push_back(rg);
+                }
+            }
+            std::cout << "Row groups: reading " << row_groups.size() << " of "
+                      << metadata->num_row_groups() << std::endl;
+            if (multi_day > 0 && (!filter.dte.empty() || filter.session))
+            {
+                std::cerr << "Warning: " << multi_day << " row groups span several days, so DTE/session "
+                          << "pushdown cannot skip them; convert with --day-row-groups for that" << std::endl;
+            }
+
+            PARQUET_THROW_NOT_OK(reader->ReadRowGroups(row_groups, indices, &table));
+
+            // Trim to the exact date range; time-sorted data keeps it contiguous
+            if (!filter.from_date.empty() || !filter.to_date.empty())
+            {
+                ChunkCursor<arrow::StringArray> timestamp(table->GetColumnByName("timestamp"));
+                int64_t begin = -1;
+                int64_t end = -1;
+                int64_t matched = 0;
+                for (int64_t i = 0; i < table->num_rows(); ++i)
+                {
+                    if (inDateRange(toStringView(timestamp.next()), filter))
+                    {
+                        begin = begin < 0 ? i : begin;
+                        end = i + 1;
+                        ++matched;
+                    }
+                }
+
+                if (matched != end - begin)
+                {
+                    bars = loadRows(*table, filter);
+                    std::cout << "Loaded " << bars.size() << " bars from Parquet (unsorted, row-wise)" << std::endl;
+                    return bars;
+                }
+                table = table->Slice(std::max<int64_t>(begin, 0), matched);
+            }
+        }
+
+        // Price columns are handed over without per-row copies
+        size_t num_rows = static_cast<size_t>(table->num_rows());
+        bars.adoptPrices(priceColumn(table->GetColumnByName("open")),
+                         priceColumn(table->GetColumnByName("high")),
+                         priceColumn(table->GetColumnByName("low")),
+                         priceColumn(table->GetColumnByName("close")),
+                         has_volume ? priceColumn(table->GetColumnByName("volume"))
+                                    : Column<double>::adopt(AlignedVector<double>(num_rows, 0.0)));
+        bars.reserve(num_rows);
+
+        // Remaining fields are derived per row from string views, without allocating
+        ChunkCursor<arrow::StringArray> timestamp(table->GetColumnByName("timestamp"));
+        ChunkCursor<arrow::StringArray> date(table->GetColumnByName("date"));
+        ChunkCursor<arrow::StringArray> expiry(table->GetColumnByName("weekly_expiry_date"));
+        ChunkCursor<arrow::StringArray> dt(table->GetColumnByName("dt"));
+        ChunkCursor<arrow::Int32Array> dte(table->GetColumnByName("dte"));
+
+        for (size_t i = 0; i < num_rows; ++i)
+        {
+            if (!bars.appendRowInfo(toStringView(timestamp.next()), toStringView(date.next()),
+                                    toStringView(expiry.next()), toStringView(dt.next()), dte.next()))
+            {
+                // Rows can no longer be dropped from adopted columns; redo row by row
+                bars = loadRows(*table, filter);
+                break;
+            }
+        }
+
+        std::cout << "Loaded " << bars.size() << " bars from Parquet ("
+                  << reader->num_row_groups() << " row groups"
+                  << (bars.close().isView() ? ", zero-copy prices" : "") << ")" << std::endl;
         return bars;
     }
 
@@ -1,4 +1,5 @@
 #include "indicators/atr.h"
+#include "indicators/simd_kernels.h"
 #include <algorithm>
 #include <cmath>
 
@@ -7,34 +8,37 @@ namespace backtest
     namespace indicators
     {
 
-        ATR::ATR(int period) : period_(period) {}
+        ATR::ATR(int period) : period_(period), tr_sum_(0.0), prev_close_(0.0) {}
 
-        void ATR::calculate(const std::vector<Bar> &bars)
+        void ATR::calculate(const BarSeries &bars)
         {
             values_.clear();
             true_range_.clear();
+            tr_sum_ = 0.0;
+            prev_close_ = 0.0;
 
             if (bars.empty())
             {
                 return;
             }
 
+            const double *high = bars.high().data();
+            const double *low = bars.low().data();
+            const double *close = bars.close().data();
+
             values_.resize(bars.size(), 0.0);
             true_range_.resize(bars.size(), 0.0);
 
             // Calculate True Range
-            true_range_[0] = bars[0].high - bars[0].low;
-
-            for (size_t i = 1; i < bars.size(); ++i)
-            {
-                double tr1 = bars[i].high - bars[i].low;
-                double tr2 = std::abs(bars[i].high - bars[i - 1].close);
-                double tr3 = std::abs(bars[i].low - bars[i - 1].close);
-                true_range_[i] = std::max({tr1, tr2, tr3});
-            }
+            simd::activeKernels().true_range(high, low, close, true_range_.data(), bars.size());
+            prev_close_ = close[bars.size() - 1];
 
             if (bars.size() < static_cast<size_t>(period_))
             {
+                for (size_t i = 0; i < bars.size(); ++i)
+                {
+                    tr_sum_ += true_range_[i];
+                }
                 return;
             }
 
@@ -45,6 +49,7 @@ namespace backtest
                 sum += true_range_[i];
             }
             values_[period_ - 1] = sum / period_;
+            tr_sum_ = sum;
 
             // Calculate ATR using smoothing
             for (size_t i = period_; i < bars.size(); ++i)
@@ -53,18 +58,30 @@ namespace backtest
             }
         }
 
-        double ATR::getValue(size_t index) const
+        void ATR::advance(double high, double low, double close)
         {
-            if (index >= values_.size())
+            size_t i = values_.size();
+            double tr = high - low;
+            if (i > 0)
             {
-                return 0.0;
+                tr = std::max({tr, std::abs(high - prev_close_), std::abs(low - prev_close_)});
             }
-            return values_[index];
+            true_range_.push_back(tr);
+            prev_close_ = close;
+
+            if (i < static_cast<size_t>(period_))
+            {
+                tr_sum_ += tr;
+                values_.push_back(i + 1 == static_cast<size_t>(period_) ? tr_sum_ / period_ : 0.0);
+                return;
+            }
+
+            values_.push_back((values_[i - 1] * (period_ - 1) + tr) / period_);
         }
 
-        bool ATR::isReady(size_t index) const
+        size_t ATR::memoryUsage() const
         {
-            return index >= static_cast<size_t>(period_ - 1) && !values_.empty();
+            return (values_.capacity() + true_range_.capacity()) * sizeof(double);
         }
 
     } // namespace indicators
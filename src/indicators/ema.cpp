@@ -1,4 +1,5 @@
 #include "indicators/ema.h"
+#include <algorithm>
 #include <cmath>
 
 namespace backtest
@@ -6,48 +7,60 @@ namespace backtest
     namespace indicators
     {
 
-        EMA::EMA(int period) : period_(period)
+        EMA::EMA(int period) : period_(period), seed_sum_(0.0)
         {
             multiplier_ = 2.0 / (period_ + 1.0);
         }
 
-        void EMA::calculate(const std::vector<Bar> &bars)
+        EMA::EMA(int period, std::vector<double> values, double seed_sum) : EMA(period)
         {
+            values_ = std::move(values);
+            seed_sum_ = seed_sum;
+        }
+
+        void EMA::calculate(const BarSeries &bars)
+        {
+            const double *close = bars.close().data();
+
             values_.clear();
             values_.resize(bars.size(), 0.0);
+            seed_sum_ = 0.0;
 
-            if (bars.empty() || bars.size() < static_cast<size_t>(period_))
+            // Calculate initial SMA for first EMA value
+            size_t seed_bars = std::min(bars.size(), static_cast<size_t>(std::max(period_, 0)));
+            for (size_t i = 0; i < seed_bars; ++i)
             {
-                return;
+                seed_sum_ += close[i];
             }
 
-            // Calculate initial SMA for first EMA value
-            double sum = 0.0;
-            for (int i = 0; i < period_; ++i)
+            if (bars.empty() || bars.size() < static_cast<size_t>(period_))
             {
-                sum += bars[i].close;
+                return;
             }
-            values_[period_ - 1] = sum / period_;
+
+            values_[period_ - 1] = seed_sum_ / period_;
 
             // Calculate EMA for remaining values
             for (size_t i = period_; i < bars.size(); ++i)
             {
-                values_[i] = (bars[i].close - values_[i - 1]) * multiplier_ + values_[i - 1];
+                values_[i] = (close[i] - values_[i - 1]) * multiplier_ + values_[i - 1];
             }
         }
 
-        double EMA::getValue(size_t index) const
+        void EMA::advance(double high, double low, double close)
         {
-            if (index >= values_.size())
+            (void)high;
+            (void)low;
+
+            size_t i = values_.size();
+            if (i < static_cast<size_t>(period_))
             {
-                return 0.0;
+                seed_sum_ += close;
+                values_.push_back(i + 1 == static_cast<size_t>(period_) ? seed_sum_ / period_ : 0.0);
+                return;
             }
-            return values_[index];
-        }
 
-        bool EMA::isReady(size_t index) const
-        {
-            return index >= static_cast<size_t>(period_ - 1) && !values_.empty();
+            values_.push_back((close - values_[i - 1]) * multiplier_ + values_[i - 1]);
         }
 
     } // namespace indicators
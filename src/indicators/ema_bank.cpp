@@ -0,0 +1,113 @@
+#include "indicators/ema_bank.h"
+#include "indicators/indicator_cache.h"
+#include "indicators/simd_kernels.h"
+#include <algorithm>
+
+namespace backtest
+{
+    namespace indicators
+    {
+
+        EMABank::EMABank(std::vector<int> periods) : periods_(std::move(periods))
+        {
+            std::sort(periods_.begin(), periods_.end());
+            periods_.erase(std::unique(periods_.begin(), periods_.end()), periods_.end());
+        }
+
+        void EMABank::calculate(const BarSeries &bars)
+        {
+            const double *close = bars.close().data();
+            size_t n = bars.size();
+
+            std::vector<std::vector<double>> values(periods_.size(), std::vector<double>(n, 0.0));
+            std::vector<double> seed_sums(periods_.size(), 0.0);
+
+            // Lanes whose period fits in the data, in ascending period order
+            std::vector<size_t> lanes;
+            for (size_t k = 0; k < periods_.size(); ++k)
+            {
+                if (periods_[k] > 0 && static_cast<size_t>(periods_[k]) <= n)
+                {
+                    lanes.push_back(k);
+                }
+            }
+
+            if (!lanes.empty())
+            {
+                std::vector<double> alpha(lanes.size()), state(lanes.size());
+                std::vector<double *> out(lanes.size());
+                size_t common_start = static_cast<size_t>(periods_[lanes.back()]);
+
+                // Seed each lane with the SMA of its first period closes (running
+                // prefix sum matches EMA's summation order), then warm it up to the
+                // longest period so all lanes advance in lockstep afterwards
+                double sum = 0.0;
+                size_t next_lane = 0;
+                for (size_t i = 0; i < common_start; ++i)
+                {
+                    sum += close[i];
+                    while (next_lane < lanes.size() && static_cast<size_t>(periods_[lanes[next_lane]]) == i + 1)
+                    {
+                        size_t k = lanes[next_lane];
+                        int period = periods_[k];
+                        alpha[next_lane] = 2.0 / (period + 1.0);
+                        state[next_lane] = sum / period;
+                        out[next_lane] = values[k].data();
+                        values[k][period - 1] = state[next_lane];
+                        seed_sums[k] = sum;
+
+                        const simd::Kernels &scalar = simd::scalarKernels();
+                        scalar.ema_lanes(close, period, common_start, &alpha[next_lane],
+                                         &state[next_lane], &out[next_lane], 1);
+                        ++next_lane;
+                    }
+                }
+
+                simd::activeKernels().ema_lanes(close, common_start, n, alpha.data(), state.data(),
+                                                out.data(), lanes.size());
+            }
+
+            // Periods longer than the data are still warming up over every close
+            if (lanes.size() < periods_.size())
+            {
+                double total = 0.0;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    total += close[i];
+                }
+                for (size_t k = 0; k < periods_.size(); ++k)
+                {
+                    if (periods_[k] > 0 && static_cast<size_t>(periods_[k]) > n)
+                    {
+                        seed_sums[k] = total;
+                    }
+                }
+            }
+
+            series_.clear();
+            for (size_t k = 0; k < periods_.size(); ++k)
+            {
+                series_.push_back(std::make_shared<EMA>(periods_[k], std::move(values[k]), seed_sums[k]));
+            }
+        }
+
+        std::shared_ptr<const EMA> EMABank::getSeries(int period) const
+        {
+            auto it = std::lower_bound(periods_.begin(), periods_.end(), period);
+            if (it == periods_.end() || *it != period || series_.empty())
+            {
+                return nullptr;
+            }
+            return series_[it - periods_.begin()];
+        }
+
+        void EMABank::publish(IndicatorCache &cache, const BarSeries &bars) const
+        {
+            for (size_t k = 0; k < series_.size(); ++k)
+            {
+                cache.put<EMA>(series_[k], bars, periods_[k]);
+            }
+        }
+
+    } // namespace indicators
+} // namespace backtest
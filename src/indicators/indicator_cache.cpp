@@ -0,0 +1,178 @@
+#include "indicators/indicator_cache.h"
+#include <functional>
+
+namespace backtest
+{
+    namespace indicators
+    {
+
+        IndicatorCache::IndicatorCache(size_t memory_budget)
+            : memory_budget_(memory_budget), bytes_(0), hits_(0), misses_(0), evictions_(0) {}
+
+        size_t IndicatorCache::KeyHash::operator()(const Key &key) const
+        {
+            size_t seed = key.type.hash_code();
+            auto combine = [&seed](size_t value)
+            {
+                seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+            };
+
+            combine(std::hash<uint64_t>()(key.series_id));
+            combine(std::hash<size_t>()(key.series_size));
+            for (double param : key.params)
+            {
+                combine(std::hash<double>()(param));
+            }
+            return seed;
+        }
+
+        std::shared_future<IndicatorCache::Value> IndicatorCache::acquire(
+            const Key &key, std::promise<Value> &promise, bool &owner)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            auto it = entries_.find(key);
+            if (it != entries_.end())
+            {
+                ++hits_;
+                lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+                owner = false;
+                return it->second.future;
+            }
+
+            ++misses_;
+            lru_.push_front(key);
+
+            Entry entry;
+            entry.future = promise.get_future().share();
+            entry.lru_position = lru_.begin();
+            entry.bytes = 0;
+            entry.ready = false;
+            entries_.emplace(key, entry);
+
+            owner = true;
+            return entry.future;
+        }
+
+        void IndicatorCache::complete(const Key &key, size_t bytes)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            auto it = entries_.find(key);
+            if (it == entries_.end())
+            {
+                return;
+            }
+
+            it->second.bytes = bytes;
+            it->second.ready = true;
+            bytes_ += bytes;
+            evictLocked(&key);
+        }
+
+        void IndicatorCache::insert(const Key &key, Value value, size_t bytes)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            if (entries_.count(key))
+            {
+                return;
+            }
+
+            std::promise<Value> promise;
+            promise.set_value(std::move(value));
+            lru_.push_front(key);
+
+            Entry entry;
+            entry.future = promise.get_future().share();
+            entry.lru_position = lru_.begin();
+            entry.bytes = bytes;
+            entry.ready = true;
+            entries_.emplace(key, entry);
+
+            bytes_ += bytes;
+            evictLocked(&key);
+        }
+
+        bool IndicatorCache::containsKey(const Key &key) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return entries_.count(key) > 0;
+        }
+
+        void IndicatorCache::abandon(const Key &key)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            auto it = entries_.find(key);
+            if (it != entries_.end())
+            {
+                lru_.erase(it->second.lru_position);
+                entries_.erase(it);
+            }
+        }
+
+        void IndicatorCache::evictLocked(const Key *keep)
+        {
+            auto position = lru_.end();
+            while (bytes_ > memory_budget_ && position != lru_.begin())
+            {
+                --position;
+
+                auto it = entries_.find(*position);
+                if (!it->second.ready || (keep && *position == *keep))
+                {
+                    continue;
+                }
+
+                // In-flight entries are skipped; readers keep evicted series alive
+                bytes_ -= it->second.bytes;
+                ++evictions_;
+                position = lru_.erase(position);
+                entries_.erase(it);
+            }
+        }
+
+        IndicatorCache::Stats IndicatorCache::getStats() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            Stats stats;
+            stats.hits = hits_;
+            stats.misses = misses_;
+            stats.evictions = evictions_;
+            stats.entries = entries_.size();
+            stats.bytes = bytes_;
+            return stats;
+        }
+
+        void IndicatorCache::setMemoryBudget(size_t bytes)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            memory_budget_ = bytes;
+            evictLocked(nullptr);
+        }
+
+        void IndicatorCache::clear()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            // Drop completed entries only; in-flight owners still expect their key
+            for (auto position = lru_.begin(); position != lru_.end();)
+            {
+                auto it = entries_.find(*position);
+                if (it->second.ready)
+                {
+                    bytes_ -= it->second.bytes;
+                    entries_.erase(it);
+                    position = lru_.erase(position);
+                }
+                else
+                {
+                    ++position;
+                }
+            }
+        }
+
+    } // namespace indicators
+} // namespace backtest
@@ -1,4 +1,7 @@
 #include "indicators/keltner.h"
+#include "indicators/indicator_cache.h"
+#include "indicators/simd_kernels.h"
+#include <algorithm>
 
 namespace backtest
 {
@@ -7,13 +10,39 @@ namespace backtest
 
         KeltnerChannel::KeltnerChannel(int ema_period, int atr_period, double multiplier)
             : ema_period_(ema_period), atr_period_(atr_period),
-              multiplier_(multiplier), ema_(ema_period), atr_(atr_period) {}
+              multiplier_(multiplier) {}
 
-        void KeltnerChannel::calculate(const std::vector<Bar> &bars)
+        KeltnerChannel::KeltnerChannel(const KeltnerChannel &other)
+            : IndicatorBase(other), ema_period_(other.ema_period_), atr_period_(other.atr_period_),
+              multiplier_(other.multiplier_), ema_(other.ema_), atr_(other.atr_),
+              upper_band_(other.upper_band_), lower_band_(other.lower_band_)
+        {
+            if (other.streaming_ema_)
+            {
+                streaming_ema_ = std::make_shared<EMA>(*other.streaming_ema_);
+                ema_ = streaming_ema_;
+            }
+            if (other.streaming_atr_)
+            {
+                streaming_atr_ = std::make_shared<ATR>(*other.streaming_atr_);
+                atr_ = streaming_atr_;
+            }
+        }
+
+        void KeltnerChannel::calculate(const BarSeries &bars)
+        {
+            calculateWithCache(bars, nullptr);
+        }
+
+        void KeltnerChannel::calculateWithCache(const BarSeries &bars, IndicatorCache *cache)
         {
             values_.clear();
             upper_band_.clear();
             lower_band_.clear();
+            ema_.reset();
+            atr_.reset();
+            streaming_ema_.reset();
+            streaming_atr_.reset();
 
             if (bars.empty())
             {
@@ -21,27 +50,58 @@ namespace backtest
             }
 
             // Calculate EMA and ATR
-            ema_.calculate(bars);
-            atr_.calculate(bars);
+            ema_ = IndicatorCache::fetch<EMA>(cache, bars, ema_period_);
+            atr_ = IndicatorCache::fetch<ATR>(cache, bars, atr_period_);
 
             values_.resize(bars.size(), 0.0);
             upper_band_.resize(bars.size(), 0.0);
             lower_band_.resize(bars.size(), 0.0);
 
-            for (size_t i = 0; i < bars.size(); ++i)
+            // Bands are defined once both EMA and ATR are ready
+            size_t start = std::max(static_cast<size_t>(ema_period_ - 1),
+                                    static_cast<size_t>(atr_period_ - 1));
+            if (start >= bars.size())
             {
-                if (!ema_.isReady(i) || !atr_.isReady(i))
-                {
-                    continue;
-                }
+                return;
+            }
 
-                double middle = ema_.getValue(i);
-                double atr_value = atr_.getValue(i);
+            const double *middle = ema_->getValues().data();
+            std::copy(middle + start, middle + bars.size(), values_.begin() + start);
+            simd::activeKernels().bands(middle + start, atr_->getValues().data() + start, multiplier_,
+                                        upper_band_.data() + start, lower_band_.data() + start,
+                                        bars.size() - start);
+        }
 
-                values_[i] = middle;
-                upper_band_[i] = middle + multiplier_ * atr_value;
-                lower_band_[i] = middle - multiplier_ * atr_value;
+        void KeltnerChannel::advance(double high, double low, double close)
+        {
+            if (!streaming_ema_)
+            {
+                streaming_ema_ = makeStreaming(ema_, ema_period_);
+                streaming_atr_ = makeStreaming(atr_, atr_period_);
             }
+            streaming_ema_->update(high, low, close);
+            streaming_atr_->update(high, low, close);
+
+            size_t i = values_.size();
+            size_t start = std::max(static_cast<size_t>(ema_period_ - 1),
+                                    static_cast<size_t>(atr_period_ - 1));
+            if (i < start)
+            {
+                values_.push_back(0.0);
+                upper_band_.push_back(0.0);
+                lower_band_.push_back(0.0);
+                return;
+            }
+
+            // Same scalar kernel as the batch path so bands match bit for bit
+            double middle = streaming_ema_->getValue(i);
+            double atr = streaming_atr_->getValue(i);
+            double upper = 0.0;
+            double lower = 0.0;
+            simd::scalarKernels().bands(&middle, &atr, multiplier_, &upper, &lower, 1);
+            values_.push_back(middle);
+            upper_band_.push_back(upper);
+            lower_band_.push_back(lower);
         }
 
         double KeltnerChannel::getValue(size_t index) const
@@ -51,7 +111,12 @@ namespace backtest
 
         bool KeltnerChannel::isReady(size_t index) const
         {
-            return ema_.isReady(index) && atr_.isReady(index);
+            return ema_ && atr_ && ema_->isReady(index) && atr_->isReady(index);
+        }
+
+        size_t KeltnerChannel::memoryUsage() const
+        {
+            return (values_.capacity() + upper_band_.capacity() + lower_band_.capacity()) * sizeof(double);
         }
 
         double KeltnerChannel::getUpperBand(size_t index) const
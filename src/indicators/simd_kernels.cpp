@@ -0,0 +1,399 @@
+#include "indicators/simd_kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BACKTEST_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+// AVX-512 implies FMA; stop GCC fusing mul+add so every variant matches scalar bit for bit
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace backtest
+{
+    namespace indicators
+    {
+        namespace simd
+        {
+
+            namespace
+            {
+                // Scalar reference kernels; vector variants hand their tails to these
+
+                void trueRangeScalarFrom(const double *high, const double *low, const double *close,
+                                         double *out, size_t begin, size_t n)
+                {
+                    for (size_t i = std::max<size_t>(begin, 1); i < n; ++i)
+                    {
+                        double tr1 = high[i] - low[i];
+                        double tr2 = std::abs(high[i] - close[i - 1]);
+                        double tr3 = std::abs(low[i] - close[i - 1]);
+                        out[i] = std::max({tr1, tr2, tr3});
+                    }
+                }
+
+                void trueRangeScalar(const double *high, const double *low, const double *close,
+                                     double *out, size_t n)
+                {
+                    if (n == 0)
+                    {
+                        return;
+                    }
+                    out[0] = high[0] - low[0];
+                    trueRangeScalarFrom(high, low, close, out, 1, n);
+                }
+
+                void bandsScalar(const double *middle, const double *width, double multiplier,
+                                 double *upper, double *lower, size_t n)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        double offset = multiplier * width[i];
+                        upper[i] = middle[i] + offset;
+                        lower[i] = middle[i] - offset;
+                    }
+                }
+
+                void midpointScalar(const double *high, const double *low, double *out, size_t n)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        out[i] = (high[i] + low[i]) / 2.0;
+                    }
+                }
+
+                void emaLanesScalar(const double *close, size_t begin, size_t end, const double *alpha,
+                                    double *state, double *const *out, size_t lanes)
+                {
+                    for (size_t k = 0; k < lanes; ++k)
+                    {
+                        double value = state[k];
+                        double *series = out[k];
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            value = (close[i] - value) * alpha[k] + value;
+                            series[i] = value;
+                        }
+                        state[k] = value;
+                    }
+                }
+
+                void crossoverScalarFrom(const double *fast, const double *slow, int8_t *out,
+                                         size_t begin, size_t n)
+                {
+                    for (size_t i = std::max<size_t>(begin, 1); i < n; ++i)
+                    {
+                        bool up = fast[i - 1] <= slow[i - 1] && fast[i] > slow[i];
+                        bool down = fast[i - 1] >= slow[i - 1] && fast[i] < slow[i];
+                        out[i] = static_cast<int8_t>(up - down);
+                    }
+                }
+
+                void crossoverScalar(const double *fast, const double *slow, int8_t *out, size_t n)
+                {
+                    if (n == 0)
+                    {
+                        return;
+                    }
+                    out[0] = 0;
+                    crossoverScalarFrom(fast, slow, out, 1, n);
+                }
+
+                void trendFlipScalarFrom(const int *trend, int8_t *out, size_t begin, size_t n)
+                {
+                    for (size_t i = std::max<size_t>(begin, 1); i < n; ++i)
+                    {
+                        bool up = trend[i - 1] == -1 && trend[i] == 1;
+                        bool down = trend[i - 1] == 1 && trend[i] == -1;
+                        out[i] = static_cast<int8_t>(up - down);
+                    }
+                }
+
+                void trendFlipScalar(const int *trend, int8_t *out, size_t n)
+                {
+                    if (n == 0)
+                    {
+                        return;
+                    }
+                    out[0] = 0;
+                    trendFlipScalarFrom(trend, out, 1, n);
+                }
+
+#ifdef BACKTEST_X86_SIMD
+
+                __attribute__((target("avx2"))) void trueRangeAVX2(const double *high, const double *low,
+                                                                   const double *close, double *out, size_t n)
+                {
+                    if (n == 0)
+                    {
+                        return;
+                    }
+                    out[0] = high[0] - low[0];
+
+                    const __m256d sign_mask = _mm256_set1_pd(-0.0);
+                    size_t i = 1;
+                    for (; i + 4 <= n; i += 4)
+                    {
+                        __m256d h = _mm256_loadu_pd(high + i);
+                        __m256d l = _mm256_loadu_pd(low + i);
+                        __m256d prev_close = _mm256_loadu_pd(close + i - 1);
+
+                        __m256d tr1 = _mm256_sub_pd(h, l);
+                        __m256d tr2 = _mm256_andnot_pd(sign_mask, _mm256_sub_pd(h, prev_close));
+                        __m256d tr3 = _mm256_andnot_pd(sign_mask, _mm256_sub_pd(l, prev_close));
+                        _mm256_storeu_pd(out + i, _mm256_max_pd(_mm256_max_pd(tr1, tr2), tr3));
+                    }
+                    trueRangeScalarFrom(high, low, close, out, i, n);
+                }
+
+                __attribute__((target("avx2"))) void bandsAVX2(const double *middle, const double *width,
+                                                               double multiplier, double *upper,
+                                                               double *lower, size_t n)
+                {
+                    const __m256d mult = _mm256_set1_pd(multiplier);
+                    size_t i = 0;
+                    for (; i + 4 <= n; i += 4)
+                    {
+                        __m256d mid = _mm256_loadu_pd(middle + i);
+                        __m256d offset = _mm256_mul_pd(mult, _mm256_loadu_pd(width + i));
+                        _mm256_storeu_pd(upper + i, _mm256_add_pd(mid, offset));
+                        _mm256_storeu_pd(lower + i, _mm256_sub_pd(mid, offset));
+                    }
+                    bandsScalar(middle + i, width + i, multiplier, upper + i, lower + i, n - i);
+                }
+
+                __attribute__((target("avx2"))) void midpointAVX2(const double *high, const double *low,
+                                                                  double *out, size_t n)
+                {
+                    const __m256d half = _mm256_set1_pd(0.5);
+                    size_t i = 0;
+                    for (; i + 4 <= n; i += 4)
+                    {
+                        __m256d sum = _mm256_add_pd(_mm256_loadu_pd(high + i), _mm256_loadu_pd(low + i));
+                        _mm256_storeu_pd(out + i, _mm256_mul_pd(sum, half));
+                    }
+                    midpointScalar(high + i, low + i, out + i, n - i);
+                }
+
+                __attribute__((target("avx512f"))) void trueRangeAVX512(const double *high, const double *low,
+                                                                        const double *close, double *out, size_t n)
+                {
+                    if (n == 0)
+                    {
+                        return;
+                    }
+                    out[0] = high[0] - low[0];
+
+                    size_t i = 1;
+                    for (; i + 8 <= n; i += 8)
+                    {
+                        __m512d h = _mm512_loadu_pd(high + i);
+                        __m512d l = _mm512_loadu_pd(low + i);
+                        __m512d prev_close = _mm512_loadu_pd(close + i - 1);
+
+                        __m512d tr1 = _mm512_sub_pd(h, l);
+                        __m512d tr2 = _mm512_abs_pd(_mm512_sub_pd(h, prev_close));
+                        __m512d tr3 = _mm512_abs_pd(_mm512_sub_pd(l, prev_close));
+                        // All-lanes masked max is the same vmaxpd, but with a defined merge
+                        // source; plain _mm512_max_pd trips GCC 12's -Wmaybe-uninitialized.
+                        __m512d tr = _mm512_mask_max_pd(tr1, 0xFF, tr1, tr2);
+                        _mm512_storeu_pd(out + i, _mm512_mask_max_pd(tr, 0xFF, tr, tr3));
+                    }
+                    trueRangeScalarFrom(high, low, close, out, i, n);
+                }
+
+                __attribute__((target("avx512f"))) void bandsAVX512(const double *middle, const double *width,
+                                                                    double multiplier, double *upper,
+                                                                    double *lower, size_t n)
+                {
+                    const __m512d mult = _mm512_set1_pd(multiplier);
+                    size_t i = 0;
+                    for (; i + 8 <= n; i += 8)
+                    {
+                        __m512d mid = _mm512_loadu_pd(middle + i);
+                        __m512d offset = _mm512_mul_pd(mult, _mm512_loadu_pd(width + i));
+                        _mm512_storeu_pd(upper + i, _mm512_add_pd(mid, offset));
+                        _mm512_storeu_pd(lower + i, _mm512_sub_pd(mid, offset));
+                    }
+                    bandsScalar(middle + i, width + i, multiplier, upper + i, lower + i, n - i);
+                }
+
+                __attribute__((target("avx512f"))) void midpointAVX512(const double *high, const double *low,
+                                                                       double *out, size_t n)
+                {
+                    const __m512d half = _mm512_set1_pd(0.5);
+                    size_t i = 0;
+                    for (; i + 8 <= n; i += 8)
+                    {
+                        __m512d sum = _mm512_add_pd(_mm512_loadu_pd(high + i), _mm512_loadu_pd(low + i));
+                        _mm512_storeu_pd(out + i, _mm512_mul_pd(sum, half));
+                    }
+                    midpointScalar(high + i, low + i, out + i, n - i);
+                }
+
+                // Lanes are EMA periods: one broadcast close feeds 4 independent recurrences
+                __attribute__((target("avx2"))) void emaLanesAVX2(const double *close, size_t begin, size_t end,
+                                                                  const double *alpha, double *state,
+                                                                  double *const *out, size_t lanes)
+                {
+                    size_t k = 0;
+                    for (; k + 4 <= lanes; k += 4)
+                    {
+                        __m256d value = _mm256_loadu_pd(state + k);
+                        __m256d a = _mm256_loadu_pd(alpha + k);
+                        double *s0 = out[k], *s1 = out[k + 1], *s2 = out[k + 2], *s3 = out[k + 3];
+                        alignas(32) double lane[4];
+
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            __m256d c = _mm256_set1_pd(close[i]);
+                            value = _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(c, value), a), value);
+                            _mm256_store_pd(lane, value);
+                            s0[i] = lane[0];
+                            s1[i] = lane[1];
+                            s2[i] = lane[2];
+                            s3[i] = lane[3];
+                        }
+                        _mm256_storeu_pd(state + k, value);
+                    }
+                    emaLanesScalar(close, begin, end, alpha + k, state + k, out + k, lanes - k);
+                }
+
+                __attribute__((target("avx512f"))) void emaLanesAVX512(const double *close, size_t begin, size_t end,
+                                                                       const double *alpha, double *state,
+                                                                       double *const *out, size_t lanes)
+                {
+                    size_t k = 0;
+                    for (; k + 8 <= lanes; k += 8)
+                    {
+                        __m512d value = _mm512_loadu_pd(state + k);
+                        __m512d a = _mm512_loadu_pd(alpha + k);
+                        double *const *series = out + k;
+                        alignas(64) double lane[8];
+
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            __m512d c = _mm512_set1_pd(close[i]);
+                            value = _mm512_add_pd(_mm512_mul_pd(_mm512_sub_pd(c, value), a), value);
+                            _mm512_store_pd(lane, value);
+                            for (size_t j = 0; j < 8; ++j)
+                            {
+                                series[j][i] = lane[j];
+                            }
+                        }
+                        _mm512_storeu_pd(state + k, value);
+                    }
+                    emaLanesAVX2(close, begin, end, alpha + k, state + k, out + k, lanes - k);
+                }
+
+                // Four bars per step: compare masks become +1/-1/0 in 64-bit lanes,
+                // then the low dword of each lane is narrowed to bytes
+                __attribute__((target("avx2"))) void crossoverAVX2(const double *fast, const double *slow,
+                                                                   int8_t *out, size_t n)
+                {
+                    if (n == 0)
+                    {
+                        return;
+                    }
+                    out[0] = 0;
+
+                    const __m256i one = _mm256_set1_epi64x(1);
+                    const __m256i low_dwords = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+                    size_t i = 1;
+                    for (; i + 4 <= n; i += 4)
+                    {
+                        __m256d f_prev = _mm256_loadu_pd(fast + i - 1);
+                        __m256d s_prev = _mm256_loadu_pd(slow + i - 1);
+                        __m256d f = _mm256_loadu_pd(fast + i);
+                        __m256d s = _mm256_loadu_pd(slow + i);
+
+                        __m256d up = _mm256_and_pd(_mm256_cmp_pd(f_prev, s_prev, _CMP_LE_OQ),
+                                                   _mm256_cmp_pd(f, s, _CMP_GT_OQ));
+                        __m256d down = _mm256_and_pd(_mm256_cmp_pd(f_prev, s_prev, _CMP_GE_OQ),
+                                                     _mm256_cmp_pd(f, s, _CMP_LT_OQ));
+
+                        // up -> 1, down -> all ones (-1); never both
+                        __m256i event = _mm256_or_si256(_mm256_and_si256(_mm256_castpd_si256(up), one),
+                                                        _mm256_castpd_si256(down));
+                        __m128i dwords = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(event, low_dwords));
+                        __m128i bytes = _mm_packs_epi16(_mm_packs_epi32(dwords, dwords), _mm_setzero_si128());
+                        int32_t packed = _mm_cvtsi128_si32(bytes);
+                        std::memcpy(out + i, &packed, sizeof(packed));
+                    }
+                    crossoverScalarFrom(fast, slow, out, i, n);
+                }
+
+                __attribute__((target("avx2"))) void trendFlipAVX2(const int *trend, int8_t *out, size_t n)
+                {
+                    if (n == 0)
+                    {
+                        return;
+                    }
+                    out[0] = 0;
+
+                    const __m256i one = _mm256_set1_epi32(1);
+                    const __m256i minus_one = _mm256_set1_epi32(-1);
+                    size_t i = 1;
+                    for (; i + 8 <= n; i += 8)
+                    {
+                        __m256i prev = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(trend + i - 1));
+                        __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(trend + i));
+
+                        __m256i up = _mm256_and_si256(_mm256_cmpeq_epi32(prev, minus_one), _mm256_cmpeq_epi32(cur, one));
+                        __m256i down = _mm256_and_si256(_mm256_cmpeq_epi32(prev, one), _mm256_cmpeq_epi32(cur, minus_one));
+                        __m256i event = _mm256_or_si256(_mm256_and_si256(up, one), down);
+
+                        __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(event), _mm256_extracti128_si256(event, 1));
+                        _mm_storel_epi64(reinterpret_cast<__m128i *>(out + i), _mm_packs_epi16(words, words));
+                    }
+                    trendFlipScalarFrom(trend, out, i, n);
+                }
+
+                // Signal stages are byte-narrowing bound; AVX-512 reuses the AVX2 versions
+                const Kernels kAVX2Kernels = {"avx2", trueRangeAVX2, bandsAVX2, midpointAVX2, emaLanesAVX2,
+                                              crossoverAVX2, trendFlipAVX2};
+                const Kernels kAVX512Kernels = {"avx512", trueRangeAVX512, bandsAVX512, midpointAVX512, emaLanesAVX512,
+                                                crossoverAVX2, trendFlipAVX2};
+
+#endif // BACKTEST_X86_SIMD
+
+                const Kernels kScalarKernels = {"scalar", trueRangeScalar, bandsScalar, midpointScalar, emaLanesScalar,
+                                                crossoverScalar, trendFlipScalar};
+
+            } // namespace
+
+            const Kernels &scalarKernels()
+            {
+                return kScalarKernels;
+            }
+
+            std::vector<const Kernels *> availableKernels()
+            {
+                std::vector<const Kernels *> kernels = {&kScalarKernels};
+#ifdef BACKTEST_X86_SIMD
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx2"))
+                {
+                    kernels.push_back(&kAVX2Kernels);
+                }
+                if (__builtin_cpu_supports("avx512f"))
+                {
+                    kernels.push_back(&kAVX512Kernels);
+                }
+#endif
+                return kernels;
+            }
+
+            const Kernels &activeKernels()
+            {
+                static const Kernels *active = availableKernels().back();
+                return *active;
+            }
+
+        } // namespace simd
+    } // namespace indicators
+} // namespace backtest
@@ -1,19 +1,35 @@
 #include "indicators/sma.h"
+#include <algorithm>
 
 namespace backtest
 {
     namespace indicators
     {
 
-        SMA::SMA(int period) : period_(period) {}
+        SMA::SMA(int period) : period_(period), sum_(0.0), window_(std::max(period, 0)) {}
 
-        void SMA::calculate(const std::vector<Bar> &bars)
+        void SMA::calculate(const BarSeries &bars)
         {
+            const double *close = bars.close().data();
+
             values_.clear();
             values_.resize(bars.size(), 0.0);
+            sum_ = 0.0;
+            window_.clear();
+
+            // Keep the trailing window so update() can continue the rolling sum
+            size_t window_start = bars.size() > window_.capacity() ? bars.size() - window_.capacity() : 0;
+            for (size_t i = window_start; i < bars.size(); ++i)
+            {
+                window_.push_back(close[i]);
+            }
 
             if (bars.empty() || bars.size() < static_cast<size_t>(period_))
             {
+                for (size_t i = 0; i < bars.size(); ++i)
+                {
+                    sum_ += close[i];
+                }
                 return;
             }
 
@@ -21,16 +37,36 @@ namespace backtest
             double sum = 0.0;
             for (int i = 0; i < period_; ++i)
             {
-                sum += bars[i].close;
+                sum += close[i];
             }
             values_[period_ - 1] = sum / period_;
 
             // Calculate remaining SMAs using rolling window
             for (size_t i = period_; i < bars.size(); ++i)
             {
-                sum = sum - bars[i - period_].close + bars[i].close;
+                sum = sum - close[i - period_] + close[i];
                 values_[i] = sum / period_;
             }
+            sum_ = sum;
+        }
+
+        void SMA::advance(double high, double low, double close)
+        {
+            (void)high;
+            (void)low;
+
+            size_t i = values_.size();
+            if (i < static_cast<size_t>(period_))
+            {
+                sum_ += close;
+                window_.push_back(close);
+                values_.push_back(i + 1 == static_cast<size_t>(period_) ? sum_ / period_ : 0.0);
+                return;
+            }
+
+            sum_ = sum_ - window_.front() + close;
+            window_.push_back(close);
+            values_.push_back(sum_ / period_);
         }
 
         double SMA::getValue(size_t index) const
@@ -1,4 +1,6 @@
 #include "indicators/supertrend.h"
+#include "indicators/indicator_cache.h"
+#include "indicators/simd_kernels.h"
 
 namespace backtest
 {
@@ -6,20 +8,47 @@ namespace backtest
     {
 
         Supertrend::Supertrend(int period, double multiplier)
-            : period_(period), multiplier_(multiplier), atr_(period) {}
+            : period_(period), multiplier_(multiplier),
+              final_upper_(0.0), final_lower_(0.0), prev_close_(0.0) {}
 
-        void Supertrend::calculate(const std::vector<Bar> &bars)
+        Supertrend::Supertrend(const Supertrend &other)
+            : IndicatorBase(other), period_(other.period_), multiplier_(other.multiplier_),
+              atr_(other.atr_), trend_(other.trend_), final_upper_(other.final_upper_),
+              final_lower_(other.final_lower_), prev_close_(other.prev_close_)
+        {
+            if (other.streaming_atr_)
+            {
+                streaming_atr_ = std::make_shared<ATR>(*other.streaming_atr_);
+                atr_ = streaming_atr_;
+            }
+        }
+
+        void Supertrend::calculate(const BarSeries &bars)
+        {
+            calculateWithCache(bars, nullptr);
+        }
+
+        void Supertrend::calculateWithCache(const BarSeries &bars, IndicatorCache *cache)
         {
             values_.clear();
             trend_.clear();
+            atr_.reset();
+            streaming_atr_.reset();
+            final_upper_ = 0.0;
+            final_lower_ = 0.0;
+            prev_close_ = 0.0;
 
             if (bars.empty())
             {
                 return;
             }
 
-            // Calculate ATR first
-            atr_.calculate(bars);
+            // ATR depends only on period, so it is shared across multipliers
+            atr_ = IndicatorCache::fetch<ATR>(cache, bars, period_);
+
+            const double *high = bars.high().data();
+            const double *low = bars.low().data();
+            const double *close = bars.close().data();
 
             values_.resize(bars.size(), 0.0);
             trend_.resize(bars.size(), 0);
@@ -29,19 +58,23 @@ namespace backtest
             std::vector<double> final_upper(bars.size(), 0.0);
             std::vector<double> final_lower(bars.size(), 0.0);
 
-            for (size_t i = 0; i < bars.size(); ++i)
+            // Basic bands are data-parallel over the range where ATR is ready
+            size_t start = static_cast<size_t>(period_ - 1);
+            if (start >= bars.size())
             {
-                if (!atr_.isReady(i))
-                {
-                    continue;
-                }
-
-                double hl_avg = (bars[i].high + bars[i].low) / 2.0;
-                double atr_value = atr_.getValue(i);
+                return;
+            }
 
-                basic_upper[i] = hl_avg + multiplier_ * atr_value;
-                basic_lower[i] = hl_avg - multiplier_ * atr_value;
+            const simd::Kernels &kernels = simd::activeKernels();
+            size_t count = bars.size() - start;
+            std::vector<double> hl_avg(bars.size(), 0.0);
+            kernels.midpoint(high + start, low + start, hl_avg.data() + start, count);
+            kernels.bands(hl_avg.data() + start, atr_->getValues().data() + start, multiplier_,
+                          basic_upper.data() + start, basic_lower.data() + start, count);
 
+            // Final bands and trend carry forward sequentially
+            for (size_t i = start; i < bars.size(); ++i)
+            {
                 // Final bands with filtering
                 if (i == 0 || i < static_cast<size_t>(period_))
                 {
@@ -51,12 +84,12 @@ namespace backtest
                 else
                 {
                     final_upper[i] = (basic_upper[i] < final_upper[i - 1] ||
-                                      bars[i - 1].close > final_upper[i - 1])
+                                      close[i - 1] > final_upper[i - 1])
                                          ? basic_upper[i]
                                          : final_upper[i - 1];
 
                     final_lower[i] = (basic_lower[i] > final_lower[i - 1] ||
-                                      bars[i - 1].close < final_lower[i - 1])
+                                      close[i - 1] < final_lower[i - 1])
                                          ? basic_lower[i]
                                          : final_lower[i - 1];
                 }
@@ -71,39 +104,81 @@ namespace backtest
                 {
                     if (trend_[i - 1] == 1)
                     {
-                        trend_[i] = (bars[i].close <= final_lower[i]) ? -1 : 1;
+                        trend_[i] = (close[i] <= final_lower[i]) ? -1 : 1;
                     }
                     else
                     {
-                        trend_[i] = (bars[i].close >= final_upper[i]) ? 1 : -1;
+                        trend_[i] = (close[i] >= final_upper[i]) ? 1 : -1;
                     }
 
                     values_[i] = (trend_[i] == 1) ? final_lower[i] : final_upper[i];
                 }
             }
+
+            final_upper_ = final_upper[bars.size() - 1];
+            final_lower_ = final_lower[bars.size() - 1];
+            prev_close_ = close[bars.size() - 1];
         }
 
-        double Supertrend::getValue(size_t index) const
+        void Supertrend::advance(double high, double low, double close)
         {
-            if (index >= values_.size())
+            if (!streaming_atr_)
             {
-                return 0.0;
+                streaming_atr_ = makeStreaming(atr_, period_);
             }
-            return values_[index];
-        }
+            streaming_atr_->update(high, low, close);
 
-        bool Supertrend::isReady(size_t index) const
-        {
-            return atr_.isReady(index) && index < trend_.size();
-        }
+            size_t i = values_.size();
+            if (i < static_cast<size_t>(period_ - 1))
+            {
+                values_.push_back(0.0);
+                trend_.push_back(0);
+                prev_close_ = close;
+                return;
+            }
 
-        int Supertrend::getTrend(size_t index) const
-        {
-            if (index >= trend_.size())
+            // Same scalar kernels as the batch path so values match bit for bit
+            const simd::Kernels &kernels = simd::scalarKernels();
+            double hl_avg = 0.0;
+            double basic_upper = 0.0;
+            double basic_lower = 0.0;
+            double atr = streaming_atr_->getValue(i);
+            kernels.midpoint(&high, &low, &hl_avg, 1);
+            kernels.bands(&hl_avg, &atr, multiplier_, &basic_upper, &basic_lower, 1);
+
+            int trend = 1;
+            if (i == 0 || i < static_cast<size_t>(period_))
             {
-                return 0;
+                final_upper_ = basic_upper;
+                final_lower_ = basic_lower;
             }
-            return trend_[index];
+            else
+            {
+                final_upper_ = (basic_upper < final_upper_ || prev_close_ > final_upper_)
+                                   ? basic_upper
+                                   : final_upper_;
+                final_lower_ = (basic_lower > final_lower_ || prev_close_ < final_lower_)
+                                   ? basic_lower
+                                   : final_lower_;
+
+                if (trend_[i - 1] == 1)
+                {
+                    trend = (close <= final_lower_) ? -1 : 1;
+                }
+                else
+                {
+                    trend = (close >= final_upper_) ? 1 : -1;
+                }
+            }
+
+            trend_.push_back(trend);
+            values_.push_back((trend == 1) ? final_lower_ : final_upper_);
+            prev_close_ = close;
+        }
+
+        size_t Supertrend::memoryUsage() const
+        {
+            return values_.capacity() * sizeof(double) + trend_.capacity() * sizeof(int);
         }
 
     } // namespace indicators
@@ -1,8 +1,11 @@
 #include "data_loader.h"
 #include "backtest_engine.h"
+#include "benchmark.h"
+#include "time_utils.h"
 #include "strategy/ema_crossover.h"
 #include "strategy/supertrend_strategy.h"
 #include <iostream>
+#include <sstream>
 #include <filesystem>
 #include <vector>
 
@@ -16,14 +19,47 @@ void printUsage()
               << std::endl;
     std::cout << "Options:" << std::endl;
     std::cout << "  --convert-csv      Convert market_data.csv to Parquet format" << std::endl;
+    std::cout << "  --delimiter C      CSV field delimiter for conversion (default: tab)" << std::endl;
+    std::cout << "  --trading-day-dte  DTE in trading days, not calendar days (re-converts if the file differs)" << std::endl;
+    std::cout << "  --holidays FILE    Exchange holidays (one date per line) for trading-day DTE" << std::endl;
     std::cout << "  --strategy NAME    Strategy name (EMA_Crossover, Supertrend)" << std::endl;
     std::cout << "  --params P1,P2,... Strategy parameters (comma-separated)" << std::endl;
     std::cout << "  --dte N            DTE filter (1-5, or -1 for all)" << std::endl;
     std::cout << "  --optimize         Run parameter optimization" << std::endl;
+    std::cout << "  --metrics-only     With --optimize: keep no trades, write only results_index.parquet" << std::endl;
+    std::cout << "  --top-k N          With --metrics-only: re-run the N best by PnL to log their trades" << std::endl;
+    std::cout << "  --top N            With --optimize: report the N best per objective (default 10)" << std::endl;
+    std::cout << "  --top-only         With --optimize: keep and index only those top results" << std::endl;
+    std::cout << "  --prune-dd PCT     Stop a run once its drawdown exceeds PCT percent" << std::endl;
+    std::cout << "  --prune-equity X   Stop a run once its equity falls below X" << std::endl;
+    std::cout << "  --prune-min-trades N  Stop a run with fewer than N trades at the middle bar" << std::endl;
+    std::cout << "  --halving R        With --optimize: successive halving over R data prefixes" << std::endl;
+    std::cout << "  --halving-eta E    Keep the best 1/E per halving rung (default 3)" << std::endl;
+    std::cout << "  --benchmark        Run indicator kernel and execution microbenchmarks on the loaded data" << std::endl;
+    std::cout << "  --threads N        Worker threads for optimization (default: all cores)" << std::endl;
+    std::cout << "  --pin-threads      Pin optimization workers to CPUs" << std::endl;
+    std::cout << "  --session HH:MM-HH:MM  Trading window, squared off at end (default 09:15-15:25)" << std::endl;
+    std::cout << "  --from YYYY-MM-DD  Only load bars on or after this date" << std::endl;
+    std::cout << "  --to YYYY-MM-DD    Only load bars on or before this date" << std::endl;
+    std::cout << "  --pushdown         Also skip Parquet row groups outside --dte/--session" << std::endl;
+    std::cout << "  --day-row-groups   Convert with one row group per day, so --pushdown can skip by DTE/session" << std::endl;
+    std::cout << "                     (indicators then only see the loaded bars)" << std::endl;
+    std::cout << "  --dense            Visit every bar instead of jumping between signal bars" << std::endl;
+    std::cout << "  --no-cache         Always decode Parquet; do not read or write market_data.bars" << std::endl;
     std::cout << "\nExamples:" << std::endl;
     std::cout << "  ./backtest_engine --convert-csv" << std::endl;
     std::cout << "  ./backtest_engine --strategy EMA_Crossover --params 5,20 --dte 1" << std::endl;
     std::cout << "  ./backtest_engine --strategy Supertrend --optimize" << std::endl;
+    std::cout << "  ./backtest_engine --optimize --metrics-only --top-k 20" << std::endl;
+    std::cout << "  ./backtest_engine --optimize --halving 3 --prune-dd 25" << std::endl;
+    std::cout << "  ./backtest_engine --strategy EMA_Crossover --params 5,20 --from 2024-01-01 --to 2024-06-30" << std::endl;
+}
+
+bool isValidDate(const std::string &date)
+{
+    int64_t epoch_ns = 0;
+    int offset = 0;
+    return date.size() == 10 && parseTimestamp(date + " 00:00", epoch_ns, offset);
 }
 
 std::vector<StrategyParams> generateEMACombinations()
@@ -98,6 +134,7 @@ int main(int argc, char *argv[])
 
     std::string csv_path = "market_data.csv";
     std::string parquet_path = "market_data.parquet";
+    std::string cache_path = "market_data.bars";
     std::string output_dir = "output";
 
     // Create output directory
@@ -106,10 +143,27 @@ int main(int argc, char *argv[])
 
     // Parse command line arguments
     bool convert_csv = false;
+    bool holidays_given = false;
+    DataLoader::ConvertOptions convert_options;
     bool optimize = false;
+    bool benchmark = false;
     std::string strategy_name;
     std::vector<double> params;
     int dte_filter = -1;
+    SessionCalendar session;
+    size_t num_threads = 0;
+    bool pin_threads = false;
+    bool pushdown = false;
+    bool use_cache = true;
+    bool event_driven = true;
+    bool metrics_only = false;
+    size_t top_k = 0;
+    size_t top_results = 10;
+    bool top_only = false;
+    PruneRules prune_rules;
+    size_t halving_rungs = 0;
+    double halving_eta = 3.0;
+    DataLoader::LoadFilter load_filter;
 
     for (int i = 1; i < argc; ++i)
     {
@@ -119,6 +173,32 @@ int main(int argc, char *argv[])
         {
             convert_csv = true;
         }
+        else if (arg == "--delimiter" && i + 1 < argc)
+        {
+            std::string delimiter = argv[++i];
+            if (delimiter == "tab" || delimiter == "\\t")
+            {
+                delimiter = "\t";
+            }
+            if (delimiter.size() != 1)
+            {
+                std::cerr << "Error: Delimiter must be a single character or 'tab'" << std::endl;
+                return 1;
+            }
+            convert_options.delimiter = delimiter[0];
+        }
+        else if (arg == "--trading-day-dte")
+        {
+            convert_options.calendar.setMode(TradingCalendar::DTEMode::TradingDays);
+        }
+        else if (arg == "--holidays" && i + 1 < argc)
+        {
+            if (!convert_options.calendar.loadHolidays(argv[++i]))
+            {
+                return 1;
+            }
+            holidays_given = true;
+        }
         else if (arg == "--strategy" && i + 1 < argc)
         {
             strategy_name = argv[++i];
@@ -137,6 +217,88 @@ int main(int argc, char *argv[])
         {
             dte_filter = std::stoi(argv[++i]);
         }
+        else if (arg == "--threads" && i + 1 < argc)
+        {
+            num_threads = static_cast<size_t>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--pin-threads")
+        {
+            pin_threads = true;
+        }
+        else if (arg == "--session" && i + 1 < argc)
+        {
+            if (!SessionCalendar::parse(argv[++i], session))
+            {
+                std::cerr << "Error: Invalid session window, expected HH:MM-HH:MM" << std::endl;
+                return 1;
+            }
+        }
+        else if ((arg == "--from" || arg == "--to") && i + 1 < argc)
+        {
+            std::string date = argv[++i];
+            if (!isValidDate(date))
+            {
+                std::cerr << "Error: Invalid date for " << arg << ", expected YYYY-MM-DD" << std::endl;
+                return 1;
+            }
+            (arg == "--from" ? load_filter.from_date : load_filter.to_date) = date;
+        }
+        else if (arg == "--pushdown")
+        {
+            pushdown = true;
+        }
+        else if (arg == "--day-row-groups")
+        {
+            convert_options.min_row_group_rows = 0;
+        }
+        else if (arg == "--metrics-only")
+        {
+            metrics_only = true;
+        }
+        else if (arg == "--top-k" && i + 1 < argc)
+        {
+            top_k = static_cast<size_t>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--top" && i + 1 < argc)
+        {
+            top_results = static_cast<size_t>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--top-only")
+        {
+            top_only = true;
+        }
+        else if (arg == "--prune-dd" && i + 1 < argc)
+        {
+            prune_rules.max_drawdown_pct = std::stod(argv[++i]);
+        }
+        else if (arg == "--prune-equity" && i + 1 < argc)
+        {
+            prune_rules.min_equity = std::stod(argv[++i]);
+        }
+        else if (arg == "--prune-min-trades" && i + 1 < argc)
+        {
+            prune_rules.min_trades_by_midpoint = std::stoi(argv[++i]);
+        }
+        else if (arg == "--halving" && i + 1 < argc)
+        {
+            halving_rungs = static_cast<size_t>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--halving-eta" && i + 1 < argc)
+        {
+            halving_eta = std::stod(argv[++i]);
+        }
+        else if (arg == "--dense")
+        {
+            event_driven = false;
+        }
+        else if (arg == "--no-cache")
+        {
+            use_cache = false;
+        }
+        else if (arg == "--benchmark")
+        {
+            benchmark = true;
+        }
         else if (arg == "--optimize")
         {
             optimize = true;
@@ -148,11 +310,47 @@ int main(int argc, char *argv[])
         }
     }
 
-    // Convert CSV to Parquet if needed
-    if (convert_csv || !std::filesystem::exists(parquet_path))
+    if (holidays_given && convert_options.calendar.getMode() == TradingCalendar::DTEMode::CalendarDays)
+    {
+        std::cerr << "Warning: --holidays has no effect without --trading-day-dte" << std::endl;
+    }
+
+    // Convert CSV to Parquet if needed, including when the CSV was replaced
+    std::error_code time_error;
+    bool csv_exists = std::filesystem::exists(csv_path);
+    bool parquet_exists = std::filesystem::exists(parquet_path);
+    bool csv_newer = csv_exists && parquet_exists &&
+                     std::filesystem::last_write_time(csv_path, time_error) >
+                         std::filesystem::last_write_time(parquet_path, time_error);
+
+    // DTE is computed at conversion; the file records the options it was
+    // made with, and is only redone when they differ from this run's
+    bool options_changed = false;
+    if (parquet_exists && !convert_csv)
+    {
+        std::string stored = DataLoader::readConversionTag(parquet_path);
+        std::string wanted = DataLoader::conversionTag(convert_options);
+        if (stored != wanted)
+        {
+            if (csv_exists)
+            {
+                std::cout << "\n" << parquet_path << " was converted with " << stored
+                          << ", this run asks for " << wanted << "; re-converting" << std::endl;
+                options_changed = true;
+            }
+            else
+            {
+                std::cerr << "Warning: " << parquet_path << " was converted with " << stored
+                          << ", not " << wanted << ", and " << csv_path
+                          << " is missing; using it as is" << std::endl;
+            }
+        }
+    }
+    if (convert_csv || options_changed || csv_newer || !parquet_exists)
     {
         std::cout << "\nStep 1: Converting CSV to Parquet format..." << std::endl;
-        if (!DataLoader::convertCSVToParquet(csv_path, parquet_path))
+        convert_options.num_threads = num_threads;
+        if (!DataLoader::convertCSVToParquet(csv_path, parquet_path, convert_options))
         {
             std::cerr << "Error: Failed to convert CSV to Parquet" << std::endl;
             return 1;
@@ -161,7 +359,19 @@ int main(int argc, char *argv[])
 
     // Load data
     std::cout << "\nStep 2: Loading market data from Parquet..." << std::endl;
-    std::vector<Bar> bars = DataLoader::loadFromParquet(parquet_path);
+    if (pushdown)
+    {
+        // Optimization sweeps every DTE, so only a single backtest narrows it
+        if (!optimize && dte_filter != -1)
+        {
+            load_filter.dte.push_back(dte_filter);
+        }
+        load_filter.session = session;
+    }
+    // Filtered loads are cheap to prune from Parquet and are not cached
+    BarSeries bars = use_cache && load_filter.empty()
+                         ? DataLoader::loadCached(parquet_path, cache_path, {csv_path})
+                         : DataLoader::loadFromParquet(parquet_path, load_filter);
     if (bars.empty())
     {
         std::cerr << "Error: No data loaded" << std::endl;
@@ -169,10 +379,26 @@ int main(int argc, char *argv[])
     }
 
     std::cout << "Loaded " << bars.size() << " bars" << std::endl;
-    std::cout << "Date range: " << bars.front().date << " to " << bars.back().date << std::endl;
+    std::cout << "Date range: " << bars.date(0) << " to " << bars.date(bars.size() - 1) << std::endl;
+    std::cout << "Column memory: " << bars.memoryUsage() / (1024 * 1024) << " MB" << std::endl;
+
+    if (benchmark)
+    {
+        Benchmark::runKernelBenchmarks(bars);
+        Benchmark::runExecutionBenchmarks(bars);
+        return 0;
+    }
 
     // Create engine
     BacktestEngine engine(2000000.0); // 20 Lakh INR
+    engine.setSessionCalendar(session);
+    engine.setThreadCount(num_threads);
+    engine.setPinThreads(pin_threads);
+    engine.setEventDriven(event_driven);
+    engine.setMetricsOnly(metrics_only, top_k);
+    engine.setTopResults(top_results, !top_only);
+    engine.setPruneRules(prune_rules);
+    engine.setSuccessiveHalving(halving_rungs, halving_eta);
 
     if (optimize)
     {
@@ -201,7 +427,7 @@ int main(int argc, char *argv[])
             bars,
             strategy_name.empty() ? "ALL" : strategy_name,
             combinations,
-            output_dir + "/trades");
+            output_dir);
 
         std::cout << "\nOptimization complete! Results saved to " << output_dir << std::endl;
         std::cout << "Run Python analysis: python analytics/analyze_results.py" << std::endl;
@@ -240,6 +466,14 @@ int main(int argc, char *argv[])
         std::cout << "Profit Factor: " << metrics.profit_factor << std::endl;
         std::cout << "Expectancy: ₹" << metrics.expectancy << std::endl;
         std::cout << "Max Drawdown: " << metrics.max_drawdown << "%" << std::endl;
+        std::cout << "Sharpe (per trade): " << metrics.sharpe_ratio << std::endl;
+        std::cout << "Sortino (per trade): " << metrics.sortino_ratio << std::endl;
+        std::cout << "Calmar: " << metrics.calmar_ratio << std::endl;
+        if (metrics.pruned())
+        {
+            std::cout << "Stopped early (" << toString(metrics.prune_reason) << ") after "
+                      << metrics.bars_covered << " of " << bars.size() << " bars" << std::endl;
+        }
 
         // Save trades
         std::string trades_file = output_dir + "/trades/single_backtest.parquet";
@@ -0,0 +1,106 @@
+#include "mapped_file.h"
+#include <fstream>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BACKTEST_HAS_MMAP 1
+#endif
+
+namespace backtest
+{
+
+    MappedFile::MappedFile() : data_(nullptr), size_(0), mapped_(false), open_(false) {}
+
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    bool MappedFile::open(const std::string &path)
+    {
+        close();
+
+#ifdef BACKTEST_HAS_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0)
+        {
+            void *mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED)
+            {
+                data_ = static_cast<const char *>(mapping);
+                size_ = static_cast<size_t>(info.st_size);
+                mapped_ = true;
+            }
+        }
+        ::close(fd);
+#endif
+
+        if (!mapped_)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file.is_open())
+            {
+                return false;
+            }
+            buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            data_ = buffer_.data();
+            size_ = buffer_.size();
+        }
+
+        open_ = true;
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+#ifdef BACKTEST_HAS_MMAP
+        if (mapped_)
+        {
+            munmap(const_cast<char *>(data_), size_);
+        }
+#endif
+        buffer_.clear();
+        data_ = nullptr;
+        size_ = 0;
+        mapped_ = false;
+        open_ = false;
+    }
+
+    void MappedFile::adviseSequential()
+    {
+#ifdef BACKTEST_HAS_MMAP
+        if (mapped_)
+        {
+            madvise(const_cast<char *>(data_), size_, MADV_SEQUENTIAL);
+        }
+#endif
+    }
+
+    void MappedFile::release(size_t offset)
+    {
+#ifdef BACKTEST_HAS_MMAP
+        if (mapped_)
+        {
+            size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            size_t length = (offset < size_ ? offset : size_) / page * page;
+            if (length > 0)
+            {
+                madvise(const_cast<char *>(data_), length, MADV_DONTNEED);
+            }
+        }
+#else
+        (void)offset;
+#endif
+    }
+
+} // namespace backtest
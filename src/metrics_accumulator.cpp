@@ -0,0 +1,71 @@
+#include "metrics_accumulator.h"
+
+namespace backtest
+{
+
+    PerformanceMetrics MetricsAccumulator::finish(const StrategyParams &params, int dte_filter) const
+    {
+        PerformanceMetrics metrics;
+        metrics.strategy_params = params.to_string();
+        metrics.dte = dte_filter;
+
+        if (count_ == 0)
+        {
+            return metrics;
+        }
+
+        metrics.total_trades = count_;
+        metrics.winning_trades = wins_;
+        metrics.losing_trades = count_ - wins_;
+        metrics.total_pnl = total_pnl_;
+        metrics.max_win = max_win_;
+        metrics.max_loss = max_loss_;
+        metrics.consecutive_wins = max_win_streak_;
+        metrics.consecutive_losses = max_loss_streak_;
+
+        metrics.total_return_pct = (total_pnl_ / initial_capital_) * 100.0;
+        metrics.win_rate = (static_cast<double>(metrics.winning_trades) / metrics.total_trades) * 100.0;
+
+        if (metrics.winning_trades > 0)
+        {
+            metrics.avg_win = gross_wins_ / metrics.winning_trades;
+        }
+        if (metrics.losing_trades > 0)
+        {
+            metrics.avg_loss = gross_losses_ / metrics.losing_trades;
+        }
+
+        if (gross_losses_ > 0)
+        {
+            metrics.profit_factor = gross_wins_ / gross_losses_;
+        }
+
+        metrics.expectancy = (metrics.win_rate / 100.0) * metrics.avg_win -
+                             ((100.0 - metrics.win_rate) / 100.0) * metrics.avg_loss;
+
+        metrics.max_drawdown = max_drawdown_;
+
+        // Per-trade ratios: mean trade PnL over its sample standard deviation
+        // (Sharpe) or over the downside deviation of losing trades (Sortino)
+        if (count_ > 1)
+        {
+            double stddev = std::sqrt(m2_ / (count_ - 1));
+            if (stddev > 0)
+            {
+                metrics.sharpe_ratio = mean_ / stddev;
+            }
+        }
+        double downside = std::sqrt(downside_sq_ / count_);
+        if (downside > 0)
+        {
+            metrics.sortino_ratio = mean_ / downside;
+        }
+        if (max_drawdown_ > 0)
+        {
+            metrics.calmar_ratio = metrics.total_return_pct / max_drawdown_;
+        }
+
+        return metrics;
+    }
+
+} // namespace backtest
@@ -0,0 +1,190 @@
+#include "result_collector.h"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace backtest
+{
+
+    namespace
+    {
+        constexpr size_t kObjectives = static_cast<size_t>(ResultCollector::Objective::Count);
+
+        // Strict "a ranks above b" for one objective; param_id breaks ties so
+        // the merged top lists do not depend on which thread ran what
+        struct Better
+        {
+            ResultCollector::Objective objective;
+
+            bool operator()(const PerformanceMetrics &a, const PerformanceMetrics &b) const
+            {
+                double score_a = ResultCollector::score(a, objective);
+                double score_b = ResultCollector::score(b, objective);
+                if (score_a != score_b)
+                {
+                    return score_a > score_b;
+                }
+                return a.param_id < b.param_id;
+            }
+        };
+
+        bool byParamId(const PerformanceMetrics &a, const PerformanceMetrics &b)
+        {
+            return a.param_id < b.param_id;
+        }
+    } // namespace
+
+    const char *ResultCollector::name(Objective objective)
+    {
+        switch (objective)
+        {
+        case Objective::Return:
+            return "Return";
+        case Objective::ProfitFactor:
+            return "Profit Factor";
+        case Objective::DrawdownAdjustedReturn:
+            return "Drawdown-Adjusted Return";
+        default:
+            return "Unknown";
+        }
+    }
+
+    double ResultCollector::score(const PerformanceMetrics &metrics, Objective objective)
+    {
+        switch (objective)
+        {
+        case Objective::Return:
+            return metrics.total_return_pct;
+        case Objective::ProfitFactor:
+            // profit_factor is left at 0 when nothing lost; all-winning runs rank first
+            if (metrics.losing_trades == 0 && metrics.winning_trades > 0)
+            {
+                return std::numeric_limits<double>::infinity();
+            }
+            return metrics.profit_factor;
+        case Objective::DrawdownAdjustedReturn:
+            // Floored so runs that barely draw down do not divide by ~0
+            return metrics.total_return_pct / std::max(metrics.max_drawdown, 1.0);
+        default:
+            return 0.0;
+        }
+    }
+
+    ResultCollector::ResultCollector(size_t num_shards, size_t top_k, bool keep_all)
+        : top_k_(top_k), keep_all_(keep_all)
+    {
+        shards_.reserve(std::max<size_t>(1, num_shards));
+        for (size_t i = 0; i < std::max<size_t>(1, num_shards); ++i)
+        {
+            shards_.push_back(std::make_unique<Shard>());
+        }
+    }
+
+    void ResultCollector::add(size_t shard_index, const PerformanceMetrics &metrics)
+    {
+        Shard &shard = *shards_[shard_index % shards_.size()];
+        ++shard.count;
+        shard.pruned += metrics.pruned() ? 1 : 0;
+        if (keep_all_)
+        {
+            shard.results.push_back(metrics);
+        }
+
+        // Pruned runs stopped early; their partial metrics do not compete
+        if (top_k_ == 0 || metrics.pruned())
+        {
+            return;
+        }
+
+        // Min-heaps under Better: the front is the worst of the current top K
+        for (size_t o = 0; o < kObjectives; ++o)
+        {
+            Better better{static_cast<Objective>(o)};
+            std::vector<PerformanceMetrics> &heap = shard.heaps[o];
+            if (heap.size() < top_k_)
+            {
+                heap.push_back(metrics);
+                std::push_heap(heap.begin(), heap.end(), better);
+            }
+            else if (better(metrics, heap.front()))
+            {
+                std::pop_heap(heap.begin(), heap.end(), better);
+                heap.back() = metrics;
+                std::push_heap(heap.begin(), heap.end(), better);
+            }
+        }
+    }
+
+    size_t ResultCollector::count() const
+    {
+        size_t total = 0;
+        for (const auto &shard : shards_)
+        {
+            total += shard->count;
+        }
+        return total;
+    }
+
+    size_t ResultCollector::prunedCount() const
+    {
+        size_t total = 0;
+        for (const auto &shard : shards_)
+        {
+            total += shard->pruned;
+        }
+        return total;
+    }
+
+    std::vector<PerformanceMetrics> ResultCollector::takeAll()
+    {
+        size_t total = 0;
+        for (const auto &shard : shards_)
+        {
+            total += shard->results.size();
+        }
+
+        std::vector<PerformanceMetrics> merged;
+        merged.reserve(total);
+        for (auto &shard : shards_)
+        {
+            std::move(shard->results.begin(), shard->results.end(), std::back_inserter(merged));
+            shard->results.clear();
+            shard->results.shrink_to_fit();
+        }
+        std::sort(merged.begin(), merged.end(), byParamId);
+        return merged;
+    }
+
+    std::vector<PerformanceMetrics> ResultCollector::top(Objective objective) const
+    {
+        std::vector<PerformanceMetrics> merged;
+        for (const auto &shard : shards_)
+        {
+            const auto &heap = shard->heaps[static_cast<size_t>(objective)];
+            merged.insert(merged.end(), heap.begin(), heap.end());
+        }
+
+        Better better{objective};
+        size_t k = std::min(top_k_, merged.size());
+        std::partial_sort(merged.begin(), merged.begin() + k, merged.end(), better);
+        merged.resize(k);
+        return merged;
+    }
+
+    std::vector<PerformanceMetrics> ResultCollector::topUnion() const
+    {
+        std::vector<PerformanceMetrics> merged;
+        for (size_t o = 0; o < kObjectives; ++o)
+        {
+            std::vector<PerformanceMetrics> best = top(static_cast<Objective>(o));
+            merged.insert(merged.end(), best.begin(), best.end());
+        }
+        std::sort(merged.begin(), merged.end(), byParamId);
+        merged.erase(std::unique(merged.begin(), merged.end(),
+                                 [](const PerformanceMetrics &a, const PerformanceMetrics &b)
+                                 { return a.param_id == b.param_id; }),
+                     merged.end());
+        return merged;
+    }
+
+} // namespace backtest
@@ -0,0 +1,176 @@
+#include "results_index.h"
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <parquet/arrow/writer.h>
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+namespace backtest
+{
+
+    bool ResultsIndex::save(const std::vector<PerformanceMetrics> &results,
+                            const std::vector<StrategyParams> &param_combinations,
+                            const std::string &path)
+    {
+        std::vector<const PerformanceMetrics *> rows;
+        rows.reserve(results.size());
+        for (const auto &metrics : results)
+        {
+            rows.push_back(&metrics);
+        }
+        std::sort(rows.begin(), rows.end(), [](const PerformanceMetrics *a, const PerformanceMetrics *b)
+                  { return a->param_id < b->param_id; });
+
+        std::vector<std::shared_ptr<arrow::Field>> fields = {
+            arrow::field("param_id", arrow::uint32()),
+            arrow::field("strategy_params", arrow::utf8()),
+            arrow::field("dte", arrow::int32()),
+            arrow::field("total_trades", arrow::int32()),
+            arrow::field("winning_trades", arrow::int32()),
+            arrow::field("losing_trades", arrow::int32()),
+            arrow::field("total_pnl", arrow::float64()),
+            arrow::field("total_return_pct", arrow::float64()),
+            arrow::field("win_rate", arrow::float64()),
+            arrow::field("avg_win", arrow::float64()),
+            arrow::field("avg_loss", arrow::float64()),
+            arrow::field("max_win", arrow::float64()),
+            arrow::field("max_loss", arrow::float64()),
+            arrow::field("profit_factor", arrow::float64()),
+            arrow::field("expectancy", arrow::float64()),
+            arrow::field("max_drawdown", arrow::float64()),
+            arrow::field("consecutive_wins", arrow::int32()),
+            arrow::field("consecutive_losses", arrow::int32()),
+            arrow::field("sharpe_ratio", arrow::float64()),
+            arrow::field("sortino_ratio", arrow::float64()),
+            arrow::field("calmar_ratio", arrow::float64()),
+            arrow::field("prune_reason", arrow::utf8()),
+            arrow::field("halving_rung", arrow::uint32()),
+            arrow::field("bars_covered", arrow::uint64())};
+        const size_t fixed_columns = fields.size();
+
+        // One float64 column per parameter position; null where a
+        // combination has fewer parameters
+        size_t num_params = 0;
+        for (const PerformanceMetrics *metrics : rows)
+        {
+            if (metrics->param_id < param_combinations.size())
+            {
+                num_params = std::max(num_params, param_combinations[metrics->param_id].params.size());
+            }
+        }
+        std::vector<std::unique_ptr<arrow::DoubleBuilder>> param_builders;
+        for (size_t p = 0; p < num_params; ++p)
+        {
+            fields.push_back(arrow::field("param_" + std::to_string(p), arrow::float64()));
+            param_builders.push_back(std::make_unique<arrow::DoubleBuilder>());
+        }
+        auto schema = arrow::schema(fields);
+
+        arrow::UInt32Builder param_id_builder;
+        arrow::StringBuilder params_builder;
+        arrow::Int32Builder dte_builder, total_builder, wins_builder, losses_builder;
+        arrow::DoubleBuilder pnl_builder, return_builder, win_rate_builder, avg_win_builder, avg_loss_builder;
+        arrow::DoubleBuilder max_win_builder, max_loss_builder, profit_factor_builder, expectancy_builder;
+        arrow::DoubleBuilder drawdown_builder;
+        arrow::Int32Builder win_streak_builder, loss_streak_builder;
+        arrow::DoubleBuilder sharpe_builder, sortino_builder, calmar_builder;
+        arrow::StringBuilder prune_reason_builder;
+        arrow::UInt32Builder halving_rung_builder;
+        arrow::UInt64Builder bars_covered_builder;
+
+        for (const PerformanceMetrics *metrics : rows)
+        {
+            param_id_builder.Append(metrics->param_id);
+            params_builder.Append(metrics->strategy_params);
+            dte_builder.Append(metrics->dte);
+            total_builder.Append(metrics->total_trades);
+            wins_builder.Append(metrics->winning_trades);
+            losses_builder.Append(metrics->losing_trades);
+            pnl_builder.Append(metrics->total_pnl);
+            return_builder.Append(metrics->total_return_pct);
+            win_rate_builder.Append(metrics->win_rate);
+            avg_win_builder.Append(metrics->avg_win);
+            avg_loss_builder.Append(metrics->avg_loss);
+            max_win_builder.Append(metrics->max_win);
+            max_loss_builder.Append(metrics->max_loss);
+            profit_factor_builder.Append(metrics->profit_factor);
+            expectancy_builder.Append(metrics->expectancy);
+            drawdown_builder.Append(metrics->max_drawdown);
+            win_streak_builder.Append(metrics->consecutive_wins);
+            loss_streak_builder.Append(metrics->consecutive_losses);
+            sharpe_builder.Append(metrics->sharpe_ratio);
+            sortino_builder.Append(metrics->sortino_ratio);
+            calmar_builder.Append(metrics->calmar_ratio);
+            prune_reason_builder.Append(std::string(toString(metrics->prune_reason)));
+            halving_rung_builder.Append(metrics->halving_rung);
+            bars_covered_builder.Append(metrics->bars_covered);
+
+            const std::vector<double> *values = metrics->param_id < param_combinations.size()
+                                                    ? &param_combinations[metrics->param_id].params
+                                                    : nullptr;
+            for (size_t p = 0; p < num_params; ++p)
+            {
+                if (values && p < values->size())
+                {
+                    param_builders[p]->Append((*values)[p]);
+                }
+                else
+                {
+                    param_builders[p]->AppendNull();
+                }
+            }
+        }
+
+        std::vector<std::shared_ptr<arrow::Array>> columns(fields.size());
+        param_id_builder.Finish(&columns[0]);
+        params_builder.Finish(&columns[1]);
+        dte_builder.Finish(&columns[2]);
+        total_builder.Finish(&columns[3]);
+        wins_builder.Finish(&columns[4]);
+        losses_builder.Finish(&columns[5]);
+        pnl_builder.Finish(&columns[6]);
+        return_builder.Finish(&columns[7]);
+        win_rate_builder.Finish(&columns[8]);
+        avg_win_builder.Finish(&columns[9]);
+        avg_loss_builder.Finish(&columns[10]);
+        max_win_builder.Finish(&columns[11]);
+        max_loss_builder.Finish(&columns[12]);
+        profit_factor_builder.Finish(&columns[13]);
+        expectancy_builder.Finish(&columns[14]);
+        drawdown_builder.Finish(&columns[15]);
+        win_streak_builder.Finish(&columns[16]);
+        loss_streak_builder.Finish(&columns[17]);
+        sharpe_builder.Finish(&columns[18]);
+        sortino_builder.Finish(&columns[19]);
+        calmar_builder.Finish(&columns[20]);
+        prune_reason_builder.Finish(&columns[21]);
+        halving_rung_builder.Finish(&columns[22]);
+        bars_covered_builder.Finish(&columns[23]);
+        for (size_t p = 0; p < num_params; ++p)
+        {
+            param_builders[p]->Finish(&columns[fixed_columns + p]);
+        }
+
+        try
+        {
+            auto table = arrow::Table::Make(schema, columns, static_cast<int64_t>(rows.size()));
+
+            std::shared_ptr<arrow::io::FileOutputStream> outfile;
+            PARQUET_ASSIGN_OR_THROW(
+                outfile,
+                arrow::io::FileOutputStream::Open(path));
+
+            PARQUET_THROW_NOT_OK(
+                parquet::arrow::WriteTable(*table, arrow::default_memory_pool(),
+                                           outfile, 50000));
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Error: Failed to write results index " << path << ": " << e.what() << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+} // namespace backtest
@@ -0,0 +1,51 @@
+#include "session_calendar.h"
+
+namespace backtest
+{
+
+    namespace
+    {
+        bool parseClock(const std::string &text, size_t pos, int &minute_of_day)
+        {
+            if (pos + 5 > text.size() || text[pos + 2] != ':')
+            {
+                return false;
+            }
+
+            for (size_t i : {pos, pos + 1, pos + 3, pos + 4})
+            {
+                if (text[i] < '0' || text[i] > '9')
+                {
+                    return false;
+                }
+            }
+
+            int hour = (text[pos] - '0') * 10 + (text[pos + 1] - '0');
+            int minute = (text[pos + 3] - '0') * 10 + (text[pos + 4] - '0');
+            if (hour > 23 || minute > 59)
+            {
+                return false;
+            }
+
+            minute_of_day = hour * 60 + minute;
+            return true;
+        }
+    } // namespace
+
+    bool SessionCalendar::parse(const std::string &window, SessionCalendar &calendar)
+    {
+        int open_minute, close_minute;
+        if (window.size() != 11 || window[5] != '-' ||
+            !parseClock(window, 0, open_minute) || !parseClock(window, 6, close_minute) ||
+            open_minute > close_minute)
+        {
+            return false;
+        }
+
+        calendar.open_minute = open_minute;
+        calendar.close_minute = close_minute;
+        calendar.square_off_minute = close_minute;
+        return true;
+    }
+
+} // namespace backtest
@@ -0,0 +1,76 @@
+#include "session_index.h"
+#include <algorithm>
+
+namespace backtest
+{
+
+    namespace
+    {
+        constexpr uint32_t kNoSquareOff = UINT32_MAX;
+    }
+
+    SessionIndex::SessionIndex(const BarSeries &bars, const SessionCalendar &session)
+        : session_(session)
+    {
+        const int8_t *dte = bars.dte().data();
+        const int16_t *minute_of_day = bars.minuteOfDay().data();
+        const uint32_t *day_index = bars.dayIndex().data();
+        size_t n = bars.size();
+
+        size_t days = bars.numTradingDays();
+        day_begin_.reserve(days + 1);
+        square_off_begin_.reserve(days);
+        day_dte_.reserve(days);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (i == 0 || day_index[i] != day_index[i - 1])
+            {
+                day_begin_.push_back(static_cast<uint32_t>(i));
+                square_off_begin_.push_back(kNoSquareOff);
+                day_dte_.push_back(dte[i]);
+            }
+
+            if (square_off_begin_.back() == kNoSquareOff && session.shouldSquareOff(minute_of_day[i]))
+            {
+                square_off_begin_.back() = static_cast<uint32_t>(i);
+            }
+            if (day_dte_.back() != dte[i])
+            {
+                day_dte_.back() = kMixedDTE;
+            }
+        }
+        day_begin_.push_back(static_cast<uint32_t>(n));
+
+        for (size_t day = 0; day < square_off_begin_.size(); ++day)
+        {
+            if (square_off_begin_[day] == kNoSquareOff)
+            {
+                square_off_begin_[day] = day_begin_[day + 1];
+            }
+        }
+    }
+
+    size_t SessionIndex::nextSquareOff(const BarSeries &bars, size_t from, size_t to, int dte_filter) const
+    {
+        const int8_t *dte = bars.dte().data();
+        const int16_t *minute_of_day = bars.minuteOfDay().data();
+        const uint32_t *day_index = bars.dayIndex().data();
+
+        for (size_t day = day_index[from]; day < numDays() && dayBegin(day) <= to; ++day)
+        {
+            size_t end = std::min(dayEnd(day), to + 1);
+            for (size_t k = std::max(from, squareOffBegin(day)); k < end; ++k)
+            {
+                bool dte_match = dte_filter == -1 || dte[k] == dte_filter;
+                if (session_.shouldSquareOff(minute_of_day[k]) &&
+                    (!dte_match || session_.isWithinTradingHours(minute_of_day[k])))
+                {
+                    return k;
+                }
+            }
+        }
+        return kNone;
+    }
+
+} // namespace backtest
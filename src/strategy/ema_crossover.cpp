@@ -1,4 +1,7 @@
 #include "strategy/ema_crossover.h"
+#include "indicators/simd_kernels.h"
+#include <algorithm>
+#include <stdexcept>
 
 namespace backtest
 {
@@ -18,68 +21,48 @@ namespace backtest
             fast_period_ = static_cast<int>(params.params[0]);
             slow_period_ = static_cast<int>(params.params[1]);
 
-            fast_ema_ = std::make_unique<indicators::EMA>(fast_period_);
-            slow_ema_ = std::make_unique<indicators::EMA>(slow_period_);
+            fast_ema_.reset();
+            slow_ema_.reset();
+            fast_stream_.reset();
+            slow_stream_.reset();
 
             in_position_ = false;
             was_long_ = false;
         }
 
-        void EMACrossover::calculateIndicators(const std::vector<Bar> &bars)
+        void EMACrossover::calculateIndicators(const BarSeries &bars)
         {
-            fast_ema_->calculate(bars);
-            slow_ema_->calculate(bars);
+            fast_ema_ = indicators::IndicatorCache::fetch<indicators::EMA>(indicator_cache_, bars, fast_period_);
+            slow_ema_ = indicators::IndicatorCache::fetch<indicators::EMA>(indicator_cache_, bars, slow_period_);
+            fast_stream_.reset();
+            slow_stream_.reset();
         }
 
-        Signal EMACrossover::generateSignal(size_t index, const std::vector<Bar> &bars)
+        void EMACrossover::updateIndicators(const BarSeries &bars)
         {
-            if (!isReady(index) || index == 0)
+            if (!fast_stream_)
             {
-                return Signal::NONE;
-            }
-
-            double fast_current = fast_ema_->getValue(index);
-            double slow_current = slow_ema_->getValue(index);
-            double fast_prev = fast_ema_->getValue(index - 1);
-            double slow_prev = slow_ema_->getValue(index - 1);
-
-            // Bullish crossover
-            if (fast_prev <= slow_prev && fast_current > slow_current)
-            {
-                if (in_position_ && !was_long_)
-                {
-                    return Signal::EXIT_SHORT;
-                }
-                if (!in_position_)
-                {
-                    in_position_ = true;
-                    was_long_ = true;
-                    return Signal::LONG;
-                }
+                fast_stream_ = indicators::makeStreaming(fast_ema_, fast_period_);
+                slow_stream_ = indicators::makeStreaming(slow_ema_, slow_period_);
             }
+            fast_stream_->updateTo(bars);
+            slow_stream_->updateTo(bars);
+        }
 
-            // Bearish crossover
-            if (fast_prev >= slow_prev && fast_current < slow_current)
+        bool EMACrossover::generateSignals(int8_t *events, size_t n) const
+        {
+            if (!fast_ema_ || !slow_ema_ || fast_ema_->getValues().size() < n || slow_ema_->getValues().size() < n)
             {
-                if (in_position_ && was_long_)
-                {
-                    return Signal::EXIT_LONG;
-                }
-                if (!in_position_)
-                {
-                    in_position_ = true;
-                    was_long_ = false;
-                    return Signal::SHORT;
-                }
+                return false;
             }
 
-            return Signal::NONE;
-        }
+            indicators::simd::activeKernels().crossover(fast_ema_->getValues().data(),
+                                                        slow_ema_->getValues().data(), events, n);
 
-        bool EMACrossover::isReady(size_t index) const
-        {
-            return fast_ema_ && slow_ema_ &&
-                   fast_ema_->isReady(index) && slow_ema_->isReady(index);
+            // Both EMAs are ready from the longer period's first value on
+            size_t ready = static_cast<size_t>(std::max(std::max(fast_period_, slow_period_) - 1, 0));
+            std::fill(events, events + std::min(ready, n), 0);
+            return true;
         }
 
         std::string EMACrossover::getParamsString() const
@@ -1,4 +1,7 @@
 #include "strategy/supertrend_strategy.h"
+#include "indicators/simd_kernels.h"
+#include <algorithm>
+#include <stdexcept>
 
 namespace backtest
 {
@@ -18,66 +21,50 @@ namespace backtest
             period_ = static_cast<int>(params.params[0]);
             multiplier_ = params.params[1];
 
-            supertrend_ = std::make_unique<indicators::Supertrend>(period_, multiplier_);
+            supertrend_.reset();
+            stream_.reset();
 
             in_position_ = false;
             last_trend_ = 0;
         }
 
-        void SupertrendStrategy::calculateIndicators(const std::vector<Bar> &bars)
+        void SupertrendStrategy::calculateIndicators(const BarSeries &bars)
         {
-            supertrend_->calculate(bars);
+            supertrend_ = indicators::IndicatorCache::fetch<indicators::Supertrend>(
+                indicator_cache_, bars, period_, multiplier_);
+            stream_.reset();
         }
 
-        Signal SupertrendStrategy::generateSignal(size_t index, const std::vector<Bar> &bars)
+        void SupertrendStrategy::updateIndicators(const BarSeries &bars)
         {
-            if (!isReady(index) || index == 0)
+            if (!stream_)
             {
-                return Signal::NONE;
+                stream_ = indicators::makeStreaming(supertrend_, period_, multiplier_);
             }
+            stream_->updateTo(bars);
+        }
 
-            int current_trend = supertrend_->getTrend(index);
-            int prev_trend = supertrend_->getTrend(index - 1);
-
-            // Trend changed from bearish to bullish
-            if (prev_trend == -1 && current_trend == 1)
+        bool SupertrendStrategy::generateSignals(int8_t *events, size_t n) const
+        {
+            if (!supertrend_)
             {
-                if (in_position_ && last_trend_ == -1)
-                {
-                    last_trend_ = current_trend;
-                    return Signal::EXIT_SHORT;
-                }
-                if (!in_position_)
-                {
-                    in_position_ = true;
-                    last_trend_ = current_trend;
-                    return Signal::LONG;
-                }
+                return false;
             }
 
-            // Trend changed from bullish to bearish
-            if (prev_trend == 1 && current_trend == -1)
+            // Signals are trend flips; bars past the computed trend stay quiet
+            const std::vector<int> &trend = supertrend_->getTrends();
+            size_t computed = std::min(trend.size(), n);
+            indicators::simd::activeKernels().trend_flip(trend.data(), events, computed);
+            std::fill(events + computed, events + n, 0);
+
+            // Readiness starts at the ATR's first value (if it has any)
+            size_t ready = static_cast<size_t>(std::max(period_ - 1, 0));
+            if (ready < computed && !isReady(ready))
             {
-                if (in_position_ && last_trend_ == 1)
-                {
-                    last_trend_ = current_trend;
-                    return Signal::EXIT_LONG;
-                }
-                if (!in_position_)
-                {
-                    in_position_ = true;
-                    last_trend_ = current_trend;
-                    return Signal::SHORT;
-                }
+                ready = computed;
             }
-
-            last_trend_ = current_trend;
-            return Signal::NONE;
-        }
-
-        bool SupertrendStrategy::isReady(size_t index) const
-        {
-            return supertrend_ && supertrend_->isReady(index);
+            std::fill(events, events + std::min(ready, computed), 0);
+            return true;
         }
 
         std::string SupertrendStrategy::getParamsString() const
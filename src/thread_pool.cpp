@@ -0,0 +1,247 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace backtest
+{
+
+    namespace
+    {
+        // Lets jobs that submit follow-up work push onto their own worker's deque
+        thread_local const WorkStealingPool *current_pool = nullptr;
+        thread_local size_t current_worker = 0;
+    } // namespace
+
+    WorkStealingPool::WorkStealingPool(size_t num_threads, bool pin_threads)
+        : epoch_(std::chrono::steady_clock::now()), queued_(0), unfinished_(0),
+          next_job_id_(0), stopping_(false)
+    {
+        size_t hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+        if (num_threads == 0)
+        {
+            num_threads = hardware_threads;
+        }
+
+        workers_.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i)
+        {
+            workers_.push_back(std::make_unique<Worker>());
+            workers_.back()->stats = WorkerStats{0, 0, 0.0};
+        }
+
+        for (size_t i = 0; i < num_threads; ++i)
+        {
+            workers_[i]->thread = std::thread(&WorkStealingPool::workerLoop, this, i);
+
+#ifdef __linux__
+            if (pin_threads)
+            {
+                cpu_set_t cpu_set;
+                CPU_ZERO(&cpu_set);
+                CPU_SET(i % hardware_threads, &cpu_set);
+                pthread_setaffinity_np(workers_[i]->thread.native_handle(), sizeof(cpu_set), &cpu_set);
+            }
+#else
+            (void)pin_threads;
+#endif
+        }
+    }
+
+    WorkStealingPool::~WorkStealingPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            stopping_ = true;
+        }
+        work_available_.notify_all();
+
+        for (auto &worker : workers_)
+        {
+            worker->thread.join();
+        }
+    }
+
+    size_t WorkStealingPool::submit(std::function<void()> job)
+    {
+        // Count the job before it becomes visible, so a worker that takes
+        // it at once never decrements queued_ below zero; until the push
+        // lands, idle workers see queued_ > 0 and rescan
+        size_t id;
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            id = next_job_id_++;
+            ++unfinished_;
+            ++queued_;
+        }
+
+        size_t target = current_pool == this ? current_worker : id % workers_.size();
+        {
+            std::lock_guard<std::mutex> lock(workers_[target]->mutex);
+            workers_[target]->queue.push_back(Task{id, std::move(job)});
+        }
+        work_available_.notify_one();
+        return id;
+    }
+
+    void WorkStealingPool::wait()
+    {
+        std::unique_lock<std::mutex> lock(state_mutex_);
+        all_done_.wait(lock, [this]()
+                       { return unfinished_ == 0; });
+
+        if (first_error_)
+        {
+            std::exception_ptr error = first_error_;
+            first_error_ = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    bool WorkStealingPool::popLocal(size_t index, Task &task)
+    {
+        Worker &worker = *workers_[index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (worker.queue.empty())
+        {
+            return false;
+        }
+
+        task = std::move(worker.queue.back());
+        worker.queue.pop_back();
+        return true;
+    }
+
+    bool WorkStealingPool::steal(size_t thief, Task &task)
+    {
+        for (size_t offset = 1; offset < workers_.size(); ++offset)
+        {
+            Worker &victim = *workers_[(thief + offset) % workers_.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.queue.empty())
+            {
+                continue;
+            }
+
+            task = std::move(victim.queue.front());
+            victim.queue.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    size_t WorkStealingPool::workerIndex() const
+    {
+        return current_pool == this ? current_worker : kNotWorker;
+    }
+
+    void WorkStealingPool::workerLoop(size_t index)
+    {
+        current_pool = this;
+        current_worker = index;
+
+        while (true)
+        {
+            Task task;
+            if (popLocal(index, task))
+            {
+                --queued_;
+                run(index, task, false);
+                continue;
+            }
+            if (steal(index, task))
+            {
+                --queued_;
+                run(index, task, true);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(state_mutex_);
+            if (queued_ > 0)
+            {
+                // A job is being handed over; rescan instead of sleeping
+                lock.unlock();
+                std::this_thread::yield();
+                continue;
+            }
+            if (stopping_)
+            {
+                return;
+            }
+            work_available_.wait(lock, [this]()
+                                 { return stopping_ || queued_ > 0; });
+        }
+    }
+
+    void WorkStealingPool::run(size_t index, Task &task, bool stolen)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        std::exception_ptr error;
+        try
+        {
+            task.fn();
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        double start_ms = std::chrono::duration<double, std::milli>(start - epoch_).count();
+        double duration_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+        Worker &worker = *workers_[index];
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.timings.push_back(JobTiming{task.id, index, start_ms, duration_ms});
+            worker.stats.jobs++;
+            worker.stats.busy_ms += duration_ms;
+            if (stolen)
+            {
+                worker.stats.steals++;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            if (error && !first_error_)
+            {
+                first_error_ = error;
+            }
+            if (--unfinished_ == 0)
+            {
+                all_done_.notify_all();
+            }
+        }
+    }
+
+    std::vector<WorkStealingPool::JobTiming> WorkStealingPool::getJobTimings() const
+    {
+        std::vector<JobTiming> timings;
+        for (const auto &worker : workers_)
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            timings.insert(timings.end(), worker->timings.begin(), worker->timings.end());
+        }
+
+        std::sort(timings.begin(), timings.end(), [](const JobTiming &a, const JobTiming &b)
+                  { return a.job_id < b.job_id; });
+        return timings;
+    }
+
+    std::vector<WorkStealingPool::WorkerStats> WorkStealingPool::getWorkerStats() const
+    {
+        std::vector<WorkerStats> stats;
+        for (const auto &worker : workers_)
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            stats.push_back(worker->stats);
+        }
+        return stats;
+    }
+
+} // namespace backtest
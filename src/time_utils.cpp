@@ -0,0 +1,144 @@
+#include "time_utils.h"
+#include <cstdio>
+
+namespace backtest
+{
+
+    namespace
+    {
+        bool parseDigits(std::string_view text, size_t pos, size_t count, int &value)
+        {
+            if (pos + count > text.size())
+            {
+                return false;
+            }
+
+            value = 0;
+            for (size_t i = pos; i < pos + count; ++i)
+            {
+                char c = text[i];
+                if (c < '0' || c > '9')
+                {
+                    return false;
+                }
+                value = value * 10 + (c - '0');
+            }
+            return true;
+        }
+
+        void civilFromDays(int64_t days, int &year, int &month, int &day)
+        {
+            days += 719468;
+            int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+            int64_t doe = days - era * 146097;
+            int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+            int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+            int64_t mp = (5 * doy + 2) / 153;
+
+            day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+            month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+            year = static_cast<int>(yoe + era * 400 + (month <= 2 ? 1 : 0));
+        }
+    } // namespace
+
+    int64_t daysFromCivil(int year, int month, int day)
+    {
+        // Howard Hinnant's days_from_civil
+        year -= month <= 2 ? 1 : 0;
+        int64_t era = (year >= 0 ? year : year - 399) / 400;
+        int64_t yoe = year - era * 400;
+        int64_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + doe - 719468;
+    }
+
+    bool parseDate(std::string_view text, int64_t &days)
+    {
+        int year, month, day;
+        bool parsed = text.size() == 10 && text[2] == '-' && text[5] == '-'
+                          ? parseDigits(text, 0, 2, day) && parseDigits(text, 3, 2, month) &&
+                                parseDigits(text, 6, 4, year)
+                          : text.size() == 10 && text[4] == '-' && text[7] == '-' &&
+                                parseDigits(text, 0, 4, year) && parseDigits(text, 5, 2, month) &&
+                                parseDigits(text, 8, 2, day);
+        if (!parsed || month < 1 || month > 12 || day < 1 || day > 31)
+        {
+            return false;
+        }
+
+        days = daysFromCivil(year, month, day);
+        return true;
+    }
+
+    bool parseTimestamp(std::string_view text, int64_t &epoch_ns, int &utc_offset_seconds)
+    {
+        // Format: YYYY-MM-DD HH:MM:SS+05:30
+        int year, month, day, hour, minute, second = 0;
+        if (!parseDigits(text, 0, 4, year) || !parseDigits(text, 5, 2, month) ||
+            !parseDigits(text, 8, 2, day) || !parseDigits(text, 11, 2, hour) ||
+            !parseDigits(text, 14, 2, minute))
+        {
+            return false;
+        }
+
+        size_t pos = 16;
+        if (pos < text.size() && text[pos] == ':')
+        {
+            if (!parseDigits(text, pos + 1, 2, second))
+            {
+                return false;
+            }
+            pos += 3;
+        }
+
+        utc_offset_seconds = 0;
+        if (pos < text.size() && (text[pos] == '+' || text[pos] == '-'))
+        {
+            int offset_hours, offset_minutes;
+            if (!parseDigits(text, pos + 1, 2, offset_hours) ||
+                !parseDigits(text, pos + 4, 2, offset_minutes))
+            {
+                return false;
+            }
+            utc_offset_seconds = offset_hours * 3600 + offset_minutes * 60;
+            if (text[pos] == '-')
+            {
+                utc_offset_seconds = -utc_offset_seconds;
+            }
+        }
+
+        int64_t local_seconds = daysFromCivil(year, month, day) * kSecondsPerDay +
+                                hour * 3600 + minute * 60 + second;
+        epoch_ns = (local_seconds - utc_offset_seconds) * kNanosPerSecond;
+        return true;
+    }
+
+    std::string formatTimestamp(int64_t epoch_ns, int utc_offset_seconds)
+    {
+        int64_t local_seconds = epoch_ns / kNanosPerSecond + utc_offset_seconds;
+        int64_t days = local_seconds / kSecondsPerDay;
+        int64_t seconds_of_day = local_seconds % kSecondsPerDay;
+        if (seconds_of_day < 0)
+        {
+            seconds_of_day += kSecondsPerDay;
+            --days;
+        }
+
+        int year, month, day;
+        civilFromDays(days, year, month, day);
+
+        int offset = utc_offset_seconds < 0 ? -utc_offset_seconds : utc_offset_seconds;
+        // Room for the widest the int fields can format to, not just the
+        // usual 25 characters, so -Wformat-truncation stays quiet at -O2+
+        char buffer[48];
+        std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d %02d:%02d:%02d%c%02d:%02d",
+                      year, month, day,
+                      static_cast<int>(seconds_of_day / 3600),
+                      static_cast<int>((seconds_of_day / 60) % 60),
+                      static_cast<int>(seconds_of_day % 60),
+                      utc_offset_seconds < 0 ? '-' : '+',
+                      offset / 3600, (offset / 60) % 60);
+        return buffer;
+    }
+
+} // namespace backtest
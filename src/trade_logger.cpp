@@ -7,17 +7,34 @@
 namespace backtest
 {
 
-    TradeLogger::TradeLogger() {}
+    TradeLogger::TradeLogger() : bars_(nullptr), keep_trades_(true) {}
+
+    uint32_t TradeLogger::internRun(const std::string &strategy_name, const std::string &parameters)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint32_t id = run_parameters_.intern(parameters);
+        if (id == run_strategies_.size())
+        {
+            run_strategies_.push_back(strategy_name);
+        }
+        return id;
+    }
 
     void TradeLogger::logTrade(const Trade &trade)
     {
-        trades_.push_back(trade);
+        if (keep_trades_)
+        {
+            trades_.push_back(trade);
+        }
     }
 
     void TradeLogger::logTradeThreadSafe(const Trade &trade)
     {
-        std::lock_guard<std::mutex> lock(mutex_);
-        trades_.push_back(trade);
+        if (keep_trades_)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            trades_.push_back(trade);
+        }
     }
 
     void TradeLogger::clear()
@@ -25,6 +42,31 @@ namespace backtest
         trades_.clear();
     }
 
+    TradeRecord TradeLogger::materialize(const Trade &trade) const
+    {
+        TradeRecord record;
+        if (bars_)
+        {
+            record.entry_time = bars_->timestampString(trade.entry_index);
+            record.exit_time = bars_->timestampString(trade.exit_index);
+            record.entry_date = bars_->date(trade.entry_index);
+            record.exit_date = bars_->date(trade.exit_index);
+        }
+        record.entry_price = trade.entry_price;
+        record.exit_price = trade.exit_price;
+        record.quantity = trade.quantity;
+        record.pnl = trade.pnl;
+        record.pnl_percentage = trade.pnl_percentage;
+        record.direction = toString(trade.direction);
+        record.dte = trade.dte;
+        if (trade.run_id < run_strategies_.size())
+        {
+            record.strategy_name = run_strategies_[trade.run_id];
+            record.parameters = run_parameters_.lookup(trade.run_id);
+        }
+        return record;
+    }
+
     bool TradeLogger::saveToParquet(const std::string &filepath)
     {
         if (trades_.empty())
@@ -57,9 +99,10 @@ namespace backtest
         arrow::Int32Builder dte_builder;
         arrow::StringBuilder strategy_builder, params_builder;
 
-        // Append data
-        for (const auto &trade : trades_)
+        // Append data; strings are produced here, not in the backtest loop
+        for (const auto &logged : trades_)
         {
+            TradeRecord trade = materialize(logged);
             entry_time_builder.Append(trade.entry_time);
             exit_time_builder.Append(trade.exit_time);
             entry_date_builder.Append(trade.entry_date);
@@ -0,0 +1,286 @@
+#include "trade_writer.h"
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/properties.h>
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iostream>
+
+namespace backtest
+{
+
+    namespace
+    {
+        // Run parameters are not repeated per row; param_id joins to the
+        // results index
+        std::shared_ptr<arrow::Schema> tradeSchema()
+        {
+            return arrow::schema({arrow::field("param_id", arrow::uint32()),
+                                  arrow::field("strategy_name", arrow::utf8()),
+                                  arrow::field("dte", arrow::int32()),
+                                  arrow::field("entry_time", arrow::utf8()),
+                                  arrow::field("exit_time", arrow::utf8()),
+                                  arrow::field("entry_date", arrow::utf8()),
+                                  arrow::field("exit_date", arrow::utf8()),
+                                  arrow::field("entry_price", arrow::float64()),
+                                  arrow::field("exit_price", arrow::float64()),
+                                  arrow::field("quantity", arrow::float64()),
+                                  arrow::field("pnl", arrow::float64()),
+                                  arrow::field("pnl_percentage", arrow::float64()),
+                                  arrow::field("direction", arrow::utf8())});
+        }
+    } // namespace
+
+    // Rows of one (strategy, DTE) partition waiting to become a row group
+    struct TradeWriter::Partition
+    {
+        arrow::UInt32Builder param_id;
+        arrow::StringBuilder strategy_name;
+        arrow::Int32Builder dte;
+        arrow::StringBuilder entry_time, exit_time;
+        arrow::StringBuilder entry_date, exit_date;
+        arrow::DoubleBuilder entry_price, exit_price;
+        arrow::DoubleBuilder quantity, pnl, pnl_percentage;
+        arrow::StringBuilder direction;
+        size_t rows = 0;
+    };
+
+    struct TradeWriter::Output
+    {
+        std::shared_ptr<arrow::Schema> schema;
+        std::shared_ptr<arrow::io::FileOutputStream> file;
+        std::unique_ptr<parquet::arrow::FileWriter> writer;
+    };
+
+    TradeWriter::TradeWriter(const std::string &filepath, size_t capacity, size_t row_group_rows)
+        : filepath_(filepath), capacity_(std::max<size_t>(1, capacity)),
+          row_group_rows_(std::max<size_t>(1, row_group_rows)), in_flight_(0),
+          stopping_(false), closed_(false), ok_(true), stats_{0, 0, 0, 0, 0.0}
+    {
+        thread_ = std::thread(&TradeWriter::ioLoop, this);
+    }
+
+    TradeWriter::~TradeWriter()
+    {
+        if (!closed_)
+        {
+            close();
+        }
+    }
+
+    void TradeWriter::submit(std::unique_ptr<TradeLogger> logger, uint32_t param_id)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (queue_.size() >= capacity_)
+        {
+            auto start = std::chrono::steady_clock::now();
+            not_full_.wait(lock, [this]()
+                           { return queue_.size() < capacity_; });
+            stats_.blocked_ms += std::chrono::duration<double, std::milli>(
+                                     std::chrono::steady_clock::now() - start)
+                                     .count();
+        }
+        queue_.push_back(Batch{std::move(logger), param_id});
+        lock.unlock();
+        not_empty_.notify_one();
+    }
+
+    void TradeWriter::flush()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this]()
+                   { return queue_.empty() && in_flight_ == 0; });
+    }
+
+    bool TradeWriter::close()
+    {
+        if (closed_)
+        {
+            return ok_;
+        }
+
+        flush();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        not_empty_.notify_all();
+        thread_.join();
+
+        // The I/O thread is gone; finish its partitions here, in key order
+        for (auto &entry : partitions_)
+        {
+            if (entry.second->rows > 0)
+            {
+                writePartition(*entry.second);
+            }
+        }
+        partitions_.clear();
+
+        try
+        {
+            if (!output_)
+            {
+                // No trades at all: still leave a valid, empty dataset
+                Partition empty;
+                writePartition(empty);
+            }
+            if (output_ && output_->writer)
+            {
+                PARQUET_THROW_NOT_OK(output_->writer->Close());
+                PARQUET_THROW_NOT_OK(output_->file->Close());
+            }
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Error: Failed to finish " << filepath_ << ": " << e.what() << std::endl;
+            ok_ = false;
+        }
+        output_.reset();
+        closed_ = true;
+        return ok_;
+    }
+
+    TradeWriter::Stats TradeWriter::getStats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    void TradeWriter::ioLoop()
+    {
+        while (true)
+        {
+            Batch batch;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                not_empty_.wait(lock, [this]()
+                                { return stopping_ || !queue_.empty(); });
+                if (queue_.empty())
+                {
+                    return;
+                }
+                batch = std::move(queue_.front());
+                queue_.pop_front();
+                ++in_flight_;
+            }
+            not_full_.notify_one();
+
+            consume(batch);
+            size_t trades = batch.logger->getTrades().size();
+            batch.logger.reset();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++stats_.batches;
+                stats_.trades += trades;
+                --in_flight_;
+                if (queue_.empty() && in_flight_ == 0)
+                {
+                    idle_.notify_all();
+                }
+            }
+        }
+    }
+
+    void TradeWriter::consume(Batch &batch)
+    {
+        // Strings are produced here, off the backtest threads
+        for (const Trade &logged : batch.logger->getTrades())
+        {
+            TradeRecord trade = batch.logger->materialize(logged);
+
+            std::unique_ptr<Partition> &slot = partitions_[std::make_pair(trade.strategy_name, trade.dte)];
+            if (!slot)
+            {
+                slot = std::make_unique<Partition>();
+            }
+            Partition &partition = *slot;
+
+            partition.param_id.Append(batch.param_id);
+            partition.strategy_name.Append(trade.strategy_name);
+            partition.dte.Append(trade.dte);
+            partition.entry_time.Append(trade.entry_time);
+            partition.exit_time.Append(trade.exit_time);
+            partition.entry_date.Append(trade.entry_date);
+            partition.exit_date.Append(trade.exit_date);
+            partition.entry_price.Append(trade.entry_price);
+            partition.exit_price.Append(trade.exit_price);
+            partition.quantity.Append(trade.quantity);
+            partition.pnl.Append(trade.pnl);
+            partition.pnl_percentage.Append(trade.pnl_percentage);
+            partition.direction.Append(trade.direction);
+
+            if (++partition.rows >= row_group_rows_)
+            {
+                writePartition(partition);
+            }
+        }
+    }
+
+    void TradeWriter::writePartition(Partition &partition)
+    {
+        // Finish() also resets each builder for the partition's next rows
+        std::vector<std::shared_ptr<arrow::Array>> columns(13);
+        partition.param_id.Finish(&columns[0]);
+        partition.strategy_name.Finish(&columns[1]);
+        partition.dte.Finish(&columns[2]);
+        partition.entry_time.Finish(&columns[3]);
+        partition.exit_time.Finish(&columns[4]);
+        partition.entry_date.Finish(&columns[5]);
+        partition.exit_date.Finish(&columns[6]);
+        partition.entry_price.Finish(&columns[7]);
+        partition.exit_price.Finish(&columns[8]);
+        partition.quantity.Finish(&columns[9]);
+        partition.pnl.Finish(&columns[10]);
+        partition.pnl_percentage.Finish(&columns[11]);
+        partition.direction.Finish(&columns[12]);
+        int64_t rows = static_cast<int64_t>(partition.rows);
+        partition.rows = 0;
+
+        try
+        {
+            if (!output_)
+            {
+                output_ = std::make_unique<Output>();
+                output_->schema = tradeSchema();
+                PARQUET_ASSIGN_OR_THROW(output_->file, arrow::io::FileOutputStream::Open(filepath_));
+
+                parquet::WriterProperties::Builder properties;
+                properties.enable_statistics();
+                properties.max_row_group_length(static_cast<int64_t>(row_group_rows_));
+                PARQUET_ASSIGN_OR_THROW(
+                    output_->writer,
+                    parquet::arrow::FileWriter::Open(*output_->schema, arrow::default_memory_pool(),
+                                                     output_->file, properties.build()));
+            }
+            if (!output_->writer)
+            {
+                return;
+            }
+            if (rows > 0)
+            {
+                auto table = arrow::Table::Make(output_->schema, columns, rows);
+                PARQUET_THROW_NOT_OK(output_->writer->WriteTable(*table, rows));
+
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++stats_.row_groups;
+            }
+        }
+        catch (const std::exception &e)
+        {
+            // Keep consuming so producers never stall on a broken file
+            std::cerr << "Error: Failed to write " << filepath_ << ": " << e.what() << std::endl;
+            if (output_)
+            {
+                output_->writer.reset();
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++stats_.failures;
+            ok_ = false;
+        }
+    }
+
+} // namespace backtest
@@ -0,0 +1,159 @@
+#include "trading_calendar.h"
+#include "time_utils.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace backtest
+{
+
+    namespace
+    {
+        constexpr int64_t kInvalidDay = INT64_MIN;
+
+        // 0 = Sunday ... 6 = Saturday; 1970-01-01 was a Thursday
+        int weekday(int64_t day)
+        {
+            int64_t w = (day + 4) % 7;
+            return static_cast<int>(w < 0 ? w + 7 : w);
+        }
+    } // namespace
+
+    TradingCalendar::TradingCalendar(DTEMode mode) : mode_(mode), last_dte_(-1) {}
+
+    void TradingCalendar::setMode(DTEMode mode)
+    {
+        mode_ = mode;
+        table_.clear();
+        last_dte_ = -1;
+    }
+
+    void TradingCalendar::addHoliday(int64_t day)
+    {
+        holidays_.insert(day);
+        table_.clear();
+        last_dte_ = -1;
+    }
+
+    bool TradingCalendar::loadHolidays(const std::string &path)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+        {
+            std::cerr << "Error: Cannot open holiday file: " << path << std::endl;
+            return false;
+        }
+
+        std::string line;
+        int line_number = 0;
+        while (std::getline(file, line))
+        {
+            ++line_number;
+            line = line.substr(0, line.find('#'));
+            line.erase(std::remove_if(line.begin(), line.end(), [](char c)
+                                      { return c == ' ' || c == '\t' || c == '\r'; }),
+                       line.end());
+            if (line.empty())
+            {
+                continue;
+            }
+
+            int64_t day = 0;
+            if (!parseDate(line, day))
+            {
+                std::cerr << "Warning: Invalid holiday on line " << line_number << ": " << line << std::endl;
+                continue;
+            }
+            addHoliday(day);
+        }
+        return true;
+    }
+
+    bool TradingCalendar::isTradingDay(int64_t day) const
+    {
+        int w = weekday(day);
+        return w != 0 && w != 6 && holidays_.count(day) == 0;
+    }
+
+    std::string TradingCalendar::fingerprint() const
+    {
+        // Holidays do not affect calendar-day DTE
+        if (mode_ == DTEMode::CalendarDays)
+        {
+            return "calendar";
+        }
+
+        std::vector<int64_t> days(holidays_.begin(), holidays_.end());
+        std::sort(days.begin(), days.end());
+        uint64_t hash = 14695981039346656037ULL; // FNV-1a
+        for (int64_t day : days)
+        {
+            hash = (hash ^ static_cast<uint64_t>(day)) * 1099511628211ULL;
+        }
+
+        std::ostringstream out;
+        out << "trading:" << days.size() << ":" << std::hex << hash;
+        return out.str();
+    }
+
+    int TradingCalendar::dte(int64_t day, int64_t expiry_day) const
+    {
+        if (mode_ == DTEMode::CalendarDays)
+        {
+            return static_cast<int>(std::max<int64_t>(1, std::min<int64_t>(5, expiry_day - day + 1)));
+        }
+
+        int trading_days = 1;
+        for (int64_t d = day + 1; d <= expiry_day; ++d)
+        {
+            trading_days += isTradingDay(d) ? 1 : 0;
+        }
+        return trading_days;
+    }
+
+    bool TradingCalendar::dayOf(std::string_view date, int64_t &day)
+    {
+        std::string key(date);
+        auto it = days_.find(key);
+        if (it == days_.end())
+        {
+            int64_t parsed = kInvalidDay;
+            parseDate(date, parsed);
+            it = days_.emplace(std::move(key), parsed).first;
+        }
+        day = it->second;
+        return day != kInvalidDay;
+    }
+
+    int TradingCalendar::dte(std::string_view date, std::string_view expiry)
+    {
+        if (last_dte_ >= 0 && date == last_date_ && expiry == last_expiry_)
+        {
+            return last_dte_;
+        }
+
+        int64_t day = 0;
+        int64_t expiry_day = 0;
+        int value = 1;
+        if (dayOf(date, day) && dayOf(expiry, expiry_day))
+        {
+            // Days fit comfortably in 32 bits; pack the pair into one key
+            uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(day)) << 32) |
+                           static_cast<uint32_t>(expiry_day);
+            auto it = table_.find(key);
+            if (it == table_.end())
+            {
+                it = table_.emplace(key, dte(day, expiry_day)).first;
+            }
+            value = it->second;
+        }
+
+        last_date_.assign(date);
+        last_expiry_.assign(expiry);
+        last_dte_ = value;
+        return value;
+    }
+
+} // namespace backtest